@@ -20,16 +20,49 @@ Rebol [
 ;
 ; open-connection: native [spec [text!]]
 ; open-statement: native [connection [object!] statement [object!]]
-; insert-odbc: native [statement [object!] sql [block!]]
-; copy-odbc: native [statement [object!] length [integer!]]
+; insert-odbc: native [
+;     statement [object!] sql [block!]
+;     :cursor [word!] :max-rows [integer!] :max-length [integer!]
+; ]
+; copy-odbc: native [
+;     statement [object!] :part [integer!] :prefetch [integer!]
+;     :absolute [integer!] :relative [integer!] :prior :shape [word!]
+;     :columns [block!]
+; ]
 ; close-statement: native [statement [object!]]
 ; close-connection: native [connection [object!]]
 ; update-odbc: native [connection [object!] access [logic!] commit [logic!]]
+; begin-odbc: native [connection [object!] :batch [integer!]]
+; commit-odbc: native [connection [object!] :chain]
+; rollback-odbc: native [connection [object!] :chain]
+; parallel-odbc: native [jobs [block!]]
+; info-odbc: native [connection [object!] which [word!]]
+; pool-odbc: native [connection [object!] :limit [integer!]]
+; handles-odbc: native []
+; capabilities-odbc: native [connection [object!] :override [block!]]
+; export-odbc: native [
+;     statement [object!] file [file!]
+;     :delimiter [rune!] :quote [rune!] :quoting [word!] :null-as [text!]
+;     :encoding [word!] :header
+; ]
+; import-odbc: native [
+;     statement [object!] sql [text!] file [file!]
+;     :types [block!] :delimiter [rune!] :quote [rune!] :null-as [text!]
+;     :header :batch [integer!]
+; ]
+; export-arrow-odbc: native [statement [object!] :file [file!] :batch [integer!]]
+; odbc-set-query-stats: native [on [logic!]]
+; odbc-query-stats: native [:json :reset]
+; odbc-trace: native [on [logic!] :size [integer!]]
+; odbc-trace-snapshot: native [:flush [file!]]
+; odbc-trace-decode: native [data [blob!]]
 
 
 database-prototype: context [
     hdbc: null  ; SQLHDBC handle!
     statements: []  ; statement objects
+    max-parameters: null  ; found on first ODBC-EXECUTE:ROWS
+    max-statement-length: null  ; 0 if no limit
 ]
 
 statement-prototype: context [
@@ -38,6 +71,13 @@ statement-prototype: context [
     string: null
     titles: ~
     columns: null
+    cursor: 'forward  ; SQL_ATTR_CURSOR_TYPE (INSERT-ODBC:CURSOR)
+    max-rows: 0  ; SQL_ATTR_MAX_ROWS (INSERT-ODBC:MAX-ROWS), 0 is no limit
+    max-length: 0  ; SQL_ATTR_MAX_LENGTH (INSERT-ODBC:MAX-LENGTH)
+    param-names: null  ; WORD!s for :name parameters, in order of the ?s
+    row-proto: null  ; OBJECT! copied for rows by COPY-ODBC:SHAPE
+    cached-rows: null  ; what COPY gives after ODBC-EXECUTE:CACHE
+    fingerprint: null  ; INTEGER! hash of SQL's shape for ODBC-QUERY-STATS
 ]
 
 export /odbc-statement-of: func [
@@ -136,16 +176,64 @@ sys.util/make-scheme [
             sql "SQL statement or catalog, parameter blocks reduced first"
                 [text! word! block!]
         ][
+            port.locals.cached-rows: null
             return insert-odbc port.locals blockify sql
         ]
 
         copy: func [port [port!] :part [integer!]] [
-            return copy-odbc:part port.locals part
+            let statement: port.locals
+            if statement.cached-rows [  ; see RESULT-CACHE
+                let rows: copy:part:deep statement.cached-rows (
+                    any [part, tail of statement.cached-rows]
+                )
+                statement.cached-rows: skip statement.cached-rows length of rows
+                return rows
+            ]
+            return copy-odbc:part statement part
         ]
     ]
 ]
 
 
+; When SQLFORM is run by SQLFORM-CACHED, this collects the $var, $obj.field
+; and $(expr) elements of the query in the order their values are added to
+; the parameters.  A <splice> tag is added if there are any $[...] splices.
+;
+sql-plan: null
+
+; An IN list with one ? per item would be a different SQL string (and need a
+; new prepare) for every length of list.  So the number of ?s is rounded up to
+; a power of two, with the last item repeated to fill the extra spots (this
+; doesn't change what IN matches).  That way a statement that's run with lists
+; of varying lengths only sees a few different SQL strings.
+;
+; An empty list gives IN (NULL), which matches nothing.  Beware that NOT IN
+; (NULL) matches nothing as well, not everything.
+;
+sqlform-in-list: func [
+    "Form IN (?, ...) for a list, with the ?s padded to a power of two"
+
+    return: [text!]
+    parameters "Parameter block being gathered"
+        [block!]
+    list [block!]
+][
+    if empty? list [
+        return "IN (NULL)"
+    ]
+    let count: 1
+    while [count < length of list] [
+        count: count * 2
+    ]
+    append parameters spread list
+    repeat (count - length of list) [
+        append parameters last list
+    ]
+    return unspaced [
+        "IN (" delimit ", " collect [repeat count [keep "?"]] ")"
+    ]
+]
+
 sqlform: func [
     "Form SQL Dialect as text with ? in parameter spots, $GROUP! may vaporize"
 
@@ -201,22 +289,29 @@ sqlform: func [
         ]
 
         word?:tied/ [  ; $var
+            if sql-plan [append sql-plan value]
             append parameters get untie value
             "?"
         ]
 
         tuple?:tied/ [  ; $obj.field
+            if sql-plan [append sql-plan value]
             append parameters get untie value
             "?"
         ]
 
         group?:tied/ [  ; $(expr)
+            if sql-plan [append sql-plan value]
             append parameters eval untie value
             "?"
         ]
 
         block?:tied/ [  ; $[expr] ... splice *non* text (where ? won't work)
+            if sql-plan [append sql-plan <splice>]  ; SQL text may vary
             value: untie value
+            if 'in = try first value [  ; $[in list] => IN (?, ?, ...)
+                return sqlform-in-list parameters eval next value
+            ]
             let safe: okay
             if <!> = try first value [
                 value: next value
@@ -256,6 +351,363 @@ sqlform: func [
 ]
 
 
+; Running ODBC-EXECUTE with the same query block in a loop would otherwise
+; walk the block with SQLFORM every time, just to make the same SQL text.  So
+; the text is cached along with the plan of $ elements to get parameters from.
+;
+; Entries are found by identity of the block (SAME?), most recently used
+; first.  So only CONST blocks (like the literal blocks in source code) are
+; cached, since they can't change under an entry--checking a hit needs no
+; MOLD or compare.  Blocks with $[...] splices aren't cached either, since
+; what they splice can change from one run to the next.
+;
+sql-cache: copy []  ; groups of [query sql plan]
+sql-cache-max: 64  ; entries
+
+sqlform-cached: func [
+    "SQLFORM a query block, reusing the SQL text if the block was seen before"
+
+    return: [text!]
+    parameters "Parameter block being gathered"
+        [block!]
+    query [block!]
+][
+    let pos: sql-cache
+    while [not tail? pos] [
+        if same? query pos.1 [
+            if not head? pos [  ; move to front
+                insert sql-cache spread take:part pos 3
+            ]
+            for-each 'item sql-cache.3 [
+                append parameters switch:type item [
+                    word?:tied/ [get untie item]
+                    tuple?:tied/ [get untie item]
+                    group?:tied/ [eval untie item]
+                ]
+            ]
+            return sql-cache.2
+        ]
+        pos: skip pos 3
+    ]
+
+    let saved: sql-plan  ; a $(expr) might run ODBC-EXECUTE itself
+    let plan: sql-plan: copy []
+    let sql
+    let error: sys.util/recover [sql: sqlform parameters query]
+    sql-plan: saved
+    if error [
+        panic error
+    ]
+
+    if all [const? query, not find plan <splice>] [
+        insert sql-cache spread reduce [query sql plan]
+        clear skip sql-cache (3 * sql-cache-max)
+    ]
+    return sql
+]
+
+
+; Some drivers (SQLite's among them) emulate SQL_ATTR_PARAMSET_SIZE by running
+; the statement once per row.  So for inserting many rows, ODBC-EXECUTE:ROWS
+; rewrites a one-row INSERT ... VALUES (?, ...) to have a multi-row VALUES
+; (...), (...), ... list, and runs it on chunks of the rows.  All the full
+; chunks have the same SQL text, so INSERT-ODBC only prepares it once.
+;
+; ODBC has no SQLGetInfo() for the most parameters a statement can have, so
+; the limits of some common databases are listed here (with a conservative
+; default).  The rows per chunk are also limited to 1000, since databases like
+; SQL Server won't take more in one VALUES list.
+;
+max-parameters-by-dbms: [
+    "SQLite" 999
+    "Microsoft SQL Server" 2100
+    "PostgreSQL" 32767
+    "MySQL" 65535
+    "MariaDB" 65535
+    "Oracle" 65535
+]
+
+odbc-insert-rows: func [
+    "Run a one-row INSERT ... VALUES (?, ...) on many rows, in chunks"
+
+    return: "Number of rows inserted"
+        [integer!]
+    statement [port!]
+    sql [text!]
+    rows "Blocks of values, one for each ? in the VALUES (...)"
+        [block!]
+][
+    let database: statement.locals.database
+    if not database.max-parameters [
+        let dbms: info-odbc database 'dbms-name
+        database.max-parameters: 1000
+        for-each [name limit] max-parameters-by-dbms [
+            if find dbms name [
+                database.max-parameters: limit
+            ]
+        ]
+        database.max-statement-length: (
+            info-odbc database 'max-statement-length
+        )
+    ]
+
+    ; Find the parenthesized row after the last VALUES, and count its ?s
+    ;
+    let row-start: all [
+        let values: find:last sql "VALUES"
+        find values "("
+    ]
+    let row-end: null
+    let per-row: 0
+    let depth: 0
+    let quoted: null
+    for-next 'pos any [row-start, ""] [
+        case [
+            quoted [if pos.1 = #"'" [quoted: null]]
+            pos.1 = #"'" [quoted: okay]
+            pos.1 = #"?" [per-row: per-row + 1]
+            pos.1 = #"(" [depth: depth + 1]
+            pos.1 = #")" [
+                depth: depth - 1
+                if depth = 0 [row-end: next pos, break]
+            ]
+        ]
+    ]
+    if (not row-end) or (per-row = 0) [
+        panic "ODBC-EXECUTE:ROWS needs INSERT ... VALUES (?, ...) SQL"
+    ]
+
+    let before: copy:part sql row-start
+    let template: copy:part row-start row-end
+    let after: copy row-end
+
+    let chunk: min 1000 to integer! round:down (
+        database.max-parameters / per-row
+    )
+    if database.max-statement-length > 0 [
+        chunk: min chunk to integer! round:down (
+            (database.max-statement-length - (length of before)
+                - (length of after))
+            / ((length of template) + 2)
+        )
+    ]
+    chunk: max 1 chunk
+
+    let chunk-sql: func [n [integer!]] [
+        return unspaced [
+            before (delimit ", " collect [repeat n [keep template]]) after
+        ]
+    ]
+    let full-sql: chunk-sql chunk
+
+    let count: 0
+    let pos: rows
+    while [not tail? pos] [
+        let n: min chunk length of pos
+        let parameters: make block! n * per-row
+        for-each 'row copy:part pos n [
+            if per-row <> length of row [
+                panic ["ODBC-EXECUTE:ROWS row needs" per-row "values:" row]
+            ]
+            append parameters spread row
+        ]
+        count: count + insert-odbc statement.locals compose [
+            (either n = chunk [full-sql] [chunk-sql n]) (spread parameters)
+        ]
+        pos: skip pos n
+    ]
+    return count
+]
+
+
+; ODBC-EXECUTE:CACHE keeps the titles and rows of a SELECT, keyed by the port
+; and the SQL with its parameter values.  Running the same query again before
+; the entry expires doesn't go to the server at all: the titles are returned
+; as usual, and COPY of the statement port gives the stored rows.  (The
+; COPY-ODBC native only reads from the driver, so use COPY for these.)
+;
+; DML run by INSERT-ODBC (which ODBC-EXECUTE and INSERT on a statement port
+; use), IMPORT-ODBC, or PARALLEL-ODBC drops the cached results whose SQL
+; mentions the table it changes (the name after INTO, UPDATE, DELETE FROM, or
+; TABLE).  A rollback drops them all.  Changes made by other programs are only
+; seen when entries expire.  Sizes of entries are estimated from their cells,
+; and when the total is over the budget the least recently used are dropped.
+;
+result-cache: copy []  ; groups of [key expires size names titles rows]
+result-cache-size: 0
+result-cache-ttl: 0:01:00
+result-cache-budget: 16 * 1024 * 1024  ; bytes
+
+sql-name-char: charset [#"A" - #"Z" #"a" - #"z" #"0" - #"9" "_$#."]
+
+sql-names: func [
+    "Uppercased names (and keywords) in SQL text, schema.table kept together"
+
+    return: [block!]
+    sql [text!]
+][
+    let names: copy []
+    let name: null
+    for-each 'c sql [
+        if find sql-name-char c [
+            if not name [name: make text! 16]
+            append name c
+        ] else [
+            if name [append names uppercase name]
+            name: null
+        ]
+    ]
+    if name [append names uppercase name]
+    return names
+]
+
+dml-verbs: [
+    "INSERT" "UPDATE" "DELETE" "MERGE" "REPLACE" "UPSERT"
+    "TRUNCATE" "DROP" "ALTER"
+]
+
+dml-skip-words: [  ; between the verb and the table name
+    "INTO" "FROM" "TABLE" "ONLY" "IF" "EXISTS" "OR" "REPLACE" "IGNORE"
+    "LOW_PRIORITY" "DELAYED" "QUICK"
+]
+
+clear-result-cache: func [
+    "Drop all cached results (e.g. after a rollback, which can't be traced)"
+][
+    clear result-cache
+    result-cache-size: 0
+    return ~
+]
+
+invalidate-result-cache: func [
+    "Drop cached results mentioning the table changed by SQL (if it is DML)"
+    sql [text!]
+][
+    if empty? result-cache [return ~]
+
+    let names: sql-names sql
+    if any [empty? names, not find dml-verbs first names] [return ~]
+
+    let pos: next names
+    while [all [not tail? pos, find dml-skip-words pos.1]] [
+        pos: next pos
+    ]
+    if tail? pos [  ; couldn't tell what table it changes
+        clear-result-cache
+        return ~
+    ]
+    let table: pos.1
+    let dot: find:last table "."
+    if dot [table: copy next dot]
+
+    pos: result-cache
+    while [not tail? pos] [
+        either find pos.4 table [
+            result-cache-size: result-cache-size - pos.3
+            remove:part pos 6
+        ][
+            pos: skip pos 6
+        ]
+    ]
+    return ~
+]
+
+trim-result-cache: func [
+    "Drop least recently used results until the cache is within budget"
+][
+    while [result-cache-size > result-cache-budget] [
+        let oldest: skip tail of result-cache -6
+        result-cache-size: result-cache-size - oldest.3
+        clear oldest
+    ]
+    return ~
+]
+
+cached-result: func [
+    "Titles of an unexpired cached result (setting up COPY of its rows)"
+
+    return: [<null> block!]
+    statement [port!]
+    key [blob!]
+][
+    let pos: result-cache
+    while [not tail? pos] [
+        if key = pos.1 [
+            if now:precise > pos.2 [  ; expired
+                result-cache-size: result-cache-size - pos.3
+                remove:part pos 6
+                return null
+            ]
+            if not head? pos [  ; move to front
+                insert result-cache spread take:part pos 6
+            ]
+            statement.locals.titles: copy result-cache.5
+            statement.locals.cached-rows: result-cache.6
+            return copy result-cache.5
+        ]
+        pos: skip pos 6
+    ]
+    return null
+]
+
+cache-result: func [
+    "Read all rows of a SELECT that just ran, and cache them with its titles"
+
+    statement [port!]
+    key [blob!]
+    sql [text!]
+    titles [block!]
+][
+    let rows: copy-odbc statement.locals
+    statement.locals.cached-rows: rows
+
+    let size: 64
+    for-each 'row rows [
+        size: size + 16
+        for-each 'cell row [
+            size: size + 16 + either (text? cell) or (blob? cell) [
+                length of cell
+            ][
+                0
+            ]
+        ]
+    ]
+    if size > result-cache-budget [
+        return ~
+    ]
+
+    let names: copy []  ; schema.table gives SCHEMA and TABLE
+    for-each 'name sql-names sql [
+        let dot
+        while [dot: find name "."] [
+            append names copy:part name dot
+            name: next dot
+        ]
+        append names copy name
+    ]
+
+    insert result-cache spread reduce [
+        key (now:precise + result-cache-ttl) size names (copy titles) rows
+    ]
+    result-cache-size: result-cache-size + size
+    trim-result-cache
+    return ~
+]
+
+export /odbc-set-result-cache: func [
+    "Set how long ODBC-EXECUTE:CACHE results are kept, and their memory limit"
+
+    ttl [time!]
+    budget "Estimated bytes (0 empties the cache)"
+        [integer!]
+][
+    result-cache-ttl: ttl
+    result-cache-budget: budget
+    trim-result-cache
+    return ~
+]
+
+
 ; https://forum.rebol.info/t/1234
 ;
 odbc-execute: func [
@@ -264,25 +716,228 @@ odbc-execute: func [
     statement [port!]
     query "SQL text, or block that runs SPACED with $(...) as parameters"
         [text! block!]
-    :parameters "Explicit parameters (used if SQL string contains `?`)"
-        [block!]
+    :parameters "Values for ?s in SQL text, or fields for :name markers"
+        [block! object! map!]
     :verbose "Show the SQL string before running it"
+    :cursor "Scrollable cursor type (see COPY-ODBC:ABSOLUTE etc.)"
+        [~[forward static keyset dynamic]~]
+    :max-rows "Have the server send at most this many rows"
+        [integer!]
+    :max-length "Truncate text and binary column data to this many bytes"
+        [integer!]
+    :rows "Run an INSERT ... VALUES (?, ...) for each of these value blocks"
+        [block!]
+    :cache "Reuse the rows of the same recent SELECT (see RESULT-CACHE)"
 ][
     parameters: default [copy []]
+    statement.locals.cached-rows: null
+
+    let sql
+    either block? parameters [
+        if block? query [
+            query: sqlform-cached parameters query
+        ]
+
+        if verbose [
+            print ["** SQL:" mold query]
+            print ["** PARAMETERS:" mold parameters]
+        ]
+
+        if rows [
+            if not empty? parameters [
+                panic "ODBC-EXECUTE:ROWS gets the parameters from the rows"
+            ]
+            return odbc-insert-rows statement query rows
+        ]
 
-    if block? query [
-        query: sqlform parameters query
+        ; !!! This INSERT takes a BLOCK!, not spread--this all ties into
+        ; questions about the wisdom of reusing these verbs the way R3-Alpha
+        ; did.
+        ;
+        sql: compose [(query) (spread parameters)]
+    ][  ; OBJECT! or MAP! of :name parameters
+        if block? query [
+            panic "ODBC-EXECUTE named parameters need SQL text, not a BLOCK!"
+        ]
+        sql: reduce [query parameters]
     ]
 
-    if verbose [
-        print ["** SQL:" mold query]
-        print ["** PARAMETERS:" mold parameters]
+    let key: null
+    if cache [
+        key: as blob! mold reduce [
+            statement.spec.ref sql (any [max-rows, 0]) (any [max-length, 0])
+        ]
+        let titles: cached-result statement key
+        if titles [
+            return titles
+        ]
     ]
+    let result: insert-odbc:cursor:max-rows:max-length statement.locals (
+        sql
+    ) cursor max-rows max-length
 
-    ; !!! This INSERT takes a BLOCK!, not spread--this all ties into questions
-    ; about the wisdom of reusing these verbs the way R3-Alpha did.
-    ;
-    return insert statement compose [(query) (spread parameters)]
+    if all [key, block? result] [  ; a SELECT, it returned titles
+        cache-result statement key query result
+    ]
+    return result
 ]
 
 export [odbc-execute]
+
+
+; Runs several independent queries at once.  Each database port gets its own
+; worker thread, so queries on different ports overlap while queries on the
+; same port run one after another.  An ERROR! in a job's slot means just that
+; query failed; the others still give their results.
+;
+;     odbc-execute-parallel [
+;         db1 [SELECT * FROM users WHERE id = $id]
+;         db2 "SELECT COUNT(*) FROM orders"
+;     ]
+;
+export /odbc-execute-parallel: func [
+    "Run independent queries, with one worker thread per database port"
+
+    return: "Per query: BLOCK! of rows, INTEGER! row count, or ERROR!"
+        [block!]
+    jobs "Pairs of database port and query (SQL text or dialect block)"
+        [block!]
+][
+    return parallel-odbc map-each [port query] reduce jobs [
+        let parameters: copy []
+        if block? query [
+            query: sqlform-cached parameters query
+        ]
+        compose [(port.locals) (query) (spread parameters)]
+    ]
+]
+
+
+; Exporting a big table through one connection is limited by that connection's
+; throughput.  ODBC-SCAN splits the range of an integer key column into pieces,
+; and gets each piece with its own SELECT through ODBC-EXECUTE-PARALLEL's
+; machinery--spreading the partitions round-robin over the given ports.
+;
+; Since the partitions are disjoint ranges of the key, merging sorted
+; partitions in key order doesn't need a general k-way merge: the merge
+; degenerates to concatenating the partitions in range order.  So :ORDERED
+; only costs the ORDER BY done by the server on each partition.
+;
+; Rows whose key is NULL aren't in any range, so one more SELECT gets those.
+; They come after all the others (where ORDER BY puts NULLs on most servers).
+;
+export /odbc-scan: func [
+    "Read a table with range-partitioned SELECTs run in parallel"
+
+    return: "Rows of the table (in key order if :ORDERED, NULL keys last)"
+        [block!]
+    ports "Database ports to spread the partitions across"
+        [block!]
+    table [word!]
+    key "Integer column whose range is partitioned"
+        [word!]
+    partitions [integer!]
+    :ordered "Return the rows sorted by the key"
+    :columns "Columns to get (default is all)"
+        [block!]
+][
+    ports: reduce ports
+    if partitions < 1 [
+        panic "ODBC-SCAN needs at least one partition"
+    ]
+
+    let bounds: first parallel-odbc reduce [compose [
+        ((first ports).locals)
+        (unspaced ["SELECT MIN(" key "), MAX(" key ") FROM " table])
+    ]]
+    if error? bounds [
+        panic bounds
+    ]
+    let low: bounds.1.1
+    let high: bounds.1.2
+
+    let base: unspaced [
+        "SELECT " either columns [delimit ", " columns] ["*"]
+        " FROM " table
+    ]
+
+    let jobs: collect [
+        if '~null~ <> low [  ; MIN() is NULL if no row has a non-NULL key
+            if not integer? low [
+                panic ["ODBC-SCAN key must be an integer column:" key]
+            ]
+
+            let step: 1 + to integer! round:down ((high - low) / partitions)
+
+            let sql: unspaced [
+                base " WHERE " key " >= ? AND " key " < ?"
+                either ordered [unspaced [" ORDER BY " key]] [""]
+            ]
+
+            count-up 'i partitions [
+                let lo: low + ((i - 1) * step)
+                if lo > high [
+                    break
+                ]
+                let port: pick ports (((i - 1) mod length of ports) + 1)
+                keep compose [(port.locals) (sql) (lo) (lo + step)]
+            ]
+        ]
+
+        keep compose [  ; rows with a NULL key are in no range
+            ((last ports).locals) (unspaced [base " WHERE " key " IS NULL"])
+        ]
+    ]
+
+    let rows: copy []
+    for-each 'result parallel-odbc jobs [  ; results are in partition order
+        if error? result [
+            panic result
+        ]
+        append rows spread result
+    ]
+    return rows
+]
+
+
+; Autocommit makes every statement a durable commit on the server, which is
+; slow for bulk loads.  This turns it off for the duration of CODE, and then
+; commits if CODE finishes or rolls back if it panics.  With :BATCH, a commit
+; is also done after every N statements, so large loads don't accumulate one
+; huge transaction.  (Note a rollback can then only undo the current batch.)
+;
+; Leaving CODE any other way (RETURN, THROW, BREAK...) would skip both the
+; commit and the rollback, leaving autocommit off.  So CATCH:ANY stops those
+; too, and they roll back and panic like an error.  The COMMIT is inside the
+; same guard, so if it fails the transaction is also rolled back.
+;
+export /odbc-transaction: func [
+    "Run code with autocommit off, COMMIT if it completes or ROLLBACK if not"
+
+    return: [any-value?]
+    port "Database port (not a statement port)"
+        [port!]
+    code [block!]
+    :batch "Commit after every N statements"
+        [integer!]
+][
+    let connection: port.locals
+
+    begin-odbc:batch connection batch
+
+    let ^result
+    let finished: null
+    let error: sys.util/recover [
+        catch:any [
+            ^result: eval code
+            commit-odbc connection
+            finished: okay
+        ]
+    ]
+    if finished [
+        return ^result
+    ]
+
+    sys.util/recover [rollback-odbc connection]  ; keep the original error
+    panic any [error, "ODBC-TRANSACTION code was exited early, rolled back"]
+]
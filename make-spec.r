@@ -13,15 +13,26 @@ Rebol [
         because assuming you install ODBC on a Mac using "homebrew", the
         "System Integrity Protection" model prevents Apple Silicon M1/M2/etc.
         versions of macOS from allowing it to install libraries in /usr/local
+
+     B. Outside of Windows, the ODBC driver manager is loaded with dlopen()
+        when the first connection is opened, so the executable doesn't need
+        it to run.  Use the `odbc-link-library` option to link it in as before
+        (e.g. for a fully static build).  Windows always links %odbc32, which
+        is part of the OS.
     ]--
 ]
 
 options: [
     odbc-requires-ltdl [logic!] ()
+    odbc-link-library [logic!] ()  ; see [B] above
 ]
 
 use-librebol: 'yes  ; ODBC is a great example of not depending on %sys-core.h !
 
+definitions: compose [
+    (if yes? user-config.odbc-link-library ["LOAD_ODBC_LIBRARY=0"])
+]
+
 includes: switch platform-config.os-base [
     'macOS [
         [%/opt/homebrew/include/]  ; needed for Apple Silicon builds
@@ -61,8 +72,17 @@ libraries: switch platform-config.os-base [
 ] else [
     ; On some systems (32-bit Ubuntu 12.04), odbc requires ltdl
     ;
-    compose [
-        %odbc (if yes? user-config.odbc-requires-ltdl [%ltdl])
+    ; COPY-ODBC:PREFETCH uses a worker thread, so pthreads are needed.
+    ;
+    ; dlopen() is in %dl on glibc before 2.34 (see [B] above)
+    ;
+    either yes? user-config.odbc-link-library [
+        compose [
+            %odbc (if yes? user-config.odbc-requires-ltdl [%ltdl])
+            %pthread
+        ]
+    ][
+        [%dl %pthread]
     ]
 ]
 
@@ -76,26 +96,28 @@ ldflags: switch platform-config.os-base [
     ;    necessary here but AI suggested it.)
     ;
     'macOS [  ; see [A] above, -lodbc would give us dynamic linking
-        let odbcpath: ""
-        call:shell:output --[realpath "$(brew --prefix unixodbc)"]-- odbcpath
+        if yes? user-config.odbc-link-library [  ; see [B] above, else null
+            let odbcpath: ""
+            call:shell:output --[realpath "$(brew --prefix unixodbc)"]-- odbcpath
 
-        assert [newline = take:last odbcpath]  ; [1]
-        assert [#"/" <> last odbcpath]  ; [2]
+            assert [newline = take:last odbcpath]  ; [1]
+            assert [#"/" <> last odbcpath]  ; [2]
 
-        let ltdlpath: ""
-        call:shell:output --[realpath "$(brew --prefix libtool)"]-- ltdlpath
+            let ltdlpath: ""
+            call:shell:output --[realpath "$(brew --prefix libtool)"]-- ltdlpath
 
-        assert [newline = take:last ltdlpath]  ; [1]
-        assert [#"/" <> last ltdlpath]  ; [2]
+            assert [newline = take:last ltdlpath]  ; [1]
+            assert [#"/" <> last ltdlpath]  ; [2]
 
-        print ["Brew ODBC on Mac Found in:" odbcpath]
-        print ["Brew Libtool Dynamic Loader on Mac Found in:" ltdlpath]
+            print ["Brew ODBC on Mac Found in:" odbcpath]
+            print ["Brew Libtool Dynamic Loader on Mac Found in:" ltdlpath]
 
-        reduce [
-            join odbcpath "/lib/libodbc.a"
-            join ltdlpath "/lib/libltdl.a"
+            reduce [
+                join odbcpath "/lib/libodbc.a"
+                join ltdlpath "/lib/libltdl.a"
 
-            "-liconv"  ; international conversion, e.g. iconv_close()
+                "-liconv"  ; international conversion, e.g. iconv_close()
+            ]
         ]
     ]
 ]
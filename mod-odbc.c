@@ -43,8 +43,30 @@
 #include <sql.h>  // depends on defines like VOID on Windows
 #include <sqlext.h>
 
-#if RUNTIME_CHECKS
-    #include <stdio.h>
+// Unless built with the make-spec option `odbc-link-library`, the ODBC driver
+// manager is loaded when the first connection is opened, instead of linked.
+// (odbc32.dll comes with Windows, so it is always linked there.)
+//
+#if TO_WINDOWS
+    #undef LOAD_ODBC_LIBRARY
+    #define LOAD_ODBC_LIBRARY 0
+#elif !defined(LOAD_ODBC_LIBRARY)
+    #define LOAD_ODBC_LIBRARY 1
+#endif
+
+#if LOAD_ODBC_LIBRARY
+    #include <dlfcn.h>
+#endif
+
+#include <stdlib.h>  // malloc() for memory used off the interpreter thread
+#include <stdio.h>  // FILE* for EXPORT-ODBC
+#include <stdarg.h>
+#include <errno.h>
+#include <string.h>
+
+#if !TO_WINDOWS
+    #include <pthread.h>
+    #include <time.h>  // clock_gettime() for ODBC-QUERY-STATS
 #endif
 
 #include "assert-fix.h"
@@ -58,10 +80,6 @@
 typedef RebolValue Value;
 
 
-// https://stackoverflow.com/q/58438456
-#define USE_SQLITE_DESCRIBECOL_WORKAROUND
-
-
 // The version of ODBC that this is written to use is 3.0, which was released
 // around 1995.  At time of writing (2017) it is uncommon to encounter ODBC
 // systems that don't implement at least that.  It's not clear if ODBCVER is
@@ -105,24 +123,562 @@ char g_dummy_buffer[DUMMY_BUFFER_SIZE];
 #endif
 
 
+// The interpreter is single-threaded, but ODBC handles may be used from other
+// threads so long as any one handle is only used by one thread at a time.
+// Some operations use worker threads to overlap waiting on the database with
+// work in the interpreter.  Code running on those threads must not call any
+// of the rebXXX() APIs, and must allocate with malloc() instead of rebAlloc().
+//
+// Threads here are only ever started and then joined (no pools, no locks) so
+// the abstraction over the platform thread APIs is minimal.
+//
+#if TO_WINDOWS
+    typedef HANDLE Thread;
+    #define DECLARE_THREAD_FUNCTION(name) \
+        static DWORD WINAPI name(LPVOID arg)
+    #define THREAD_FUNCTION_RESULT 0
+#else
+    typedef pthread_t Thread;
+    #define DECLARE_THREAD_FUNCTION(name) \
+        static void* name(void* arg)
+    #define THREAD_FUNCTION_RESULT nullptr
+#endif
+
+#if TO_WINDOWS
+    typedef LPTHREAD_START_ROUTINE ThreadFunction;
+#else
+    typedef void* (*ThreadFunction)(void*);
+#endif
+
+static bool Start_Thread(Thread* thread, ThreadFunction function, void* arg) {
+  #if TO_WINDOWS
+    *thread = CreateThread(nullptr, 0, function, arg, 0, nullptr);
+    return *thread != nullptr;
+  #else
+    return 0 == pthread_create(thread, nullptr, function, arg);
+  #endif
+}
+
+static void Join_Thread(Thread thread) {
+  #if TO_WINDOWS
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+  #else
+    pthread_join(thread, nullptr);
+  #endif
+}
+
+
+// Monotonic clock for timing queries (not the time of day).
+//
+static uint64_t Now_Microseconds(void) {
+  #if TO_WINDOWS
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return cast(uint64_t, counter.QuadPart) * 1000000
+        / cast(uint64_t, frequency.QuadPart);
+  #else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return cast(uint64_t, ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+  #endif
+}
+
+
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// ODBC DRIVER MANAGER LOADING
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// With LOAD_ODBC_LIBRARY, the executable doesn't need libodbc to start, or to
+// be installed at all if ODBC isn't used.  OPEN-CONNECTION does a dlopen() of
+// the first driver manager it can find, and fills in a table of pointers to
+// the SQLXxx() functions.  ODBC_FUNCTION(name) gives the entry in the table
+// (or the linked function otherwise), and each function name is #define'd to
+// call through it (see ODBC CALL TRACE), so the rest of the code calls them
+// as usual.
+//
+// Every ODBC function this file calls has to be in ODBC_FUNCTIONS.  The
+// signatures are those of the ODBC 3 headers (with 64-bit SQLLEN).
+//
+// 1. The library is never unloaded.  Some drivers register atexit() handlers
+//    or keep threads, and a HANDLE! cleaner may run after SHUTDOWN*.
+//
+// 2. iODBC (libiodbc) isn't in the list: its SQLXxxW() functions take 32-bit
+//    wchar_t strings, while this file passes UTF-16 SQLWCHAR as unixODBC and
+//    Windows expect.  Loading it would silently garble every string.
+//
+#define ODBC_FUNCTIONS(X) \
+    X(SQLAllocHandle, (SQLSMALLINT, SQLHANDLE, SQLHANDLE*)) \
+    X(SQLBindCol, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN* \
+    )) \
+    X(SQLBindParameter, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLSMALLINT, SQLSMALLINT, \
+        SQLULEN, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN* \
+    )) \
+    X(SQLCancel, (SQLHSTMT)) \
+    X(SQLCloseCursor, (SQLHSTMT)) \
+    X(SQLColAttribute, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLUSMALLINT, SQLPOINTER, SQLSMALLINT, \
+        SQLSMALLINT*, SQLLEN* \
+    )) \
+    X(SQLColAttributeW, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLUSMALLINT, SQLPOINTER, SQLSMALLINT, \
+        SQLSMALLINT*, SQLLEN* \
+    )) \
+    X(SQLColumnsW, ( \
+        SQLHSTMT, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT, \
+        SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT \
+    )) \
+    X(SQLDescribeCol, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLCHAR*, SQLSMALLINT, SQLSMALLINT*, \
+        SQLSMALLINT*, SQLULEN*, SQLSMALLINT*, SQLSMALLINT* \
+    )) \
+    X(SQLDescribeColW, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLWCHAR*, SQLSMALLINT, SQLSMALLINT*, \
+        SQLSMALLINT*, SQLULEN*, SQLSMALLINT*, SQLSMALLINT* \
+    )) \
+    X(SQLDisconnect, (SQLHDBC)) \
+    X(SQLDriverConnectW, ( \
+        SQLHDBC, SQLHWND, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT, \
+        SQLSMALLINT*, SQLUSMALLINT \
+    )) \
+    X(SQLEndTran, (SQLSMALLINT, SQLHANDLE, SQLSMALLINT)) \
+    X(SQLExecute, (SQLHSTMT)) \
+    X(SQLFetch, (SQLHSTMT)) \
+    X(SQLFetchScroll, (SQLHSTMT, SQLSMALLINT, SQLLEN)) \
+    X(SQLFreeHandle, (SQLSMALLINT, SQLHANDLE)) \
+    X(SQLFreeStmt, (SQLHSTMT, SQLUSMALLINT)) \
+    X(SQLGetConnectAttr, ( \
+        SQLHDBC, SQLINTEGER, SQLPOINTER, SQLINTEGER, SQLINTEGER* \
+    )) \
+    X(SQLGetData, ( \
+        SQLHSTMT, SQLUSMALLINT, SQLSMALLINT, SQLPOINTER, SQLLEN, SQLLEN* \
+    )) \
+    X(SQLGetFunctions, (SQLHDBC, SQLUSMALLINT, SQLUSMALLINT*)) \
+    X(SQLGetDiagRecW, ( \
+        SQLSMALLINT, SQLHANDLE, SQLSMALLINT, SQLWCHAR*, SQLINTEGER*, \
+        SQLWCHAR*, SQLSMALLINT, SQLSMALLINT* \
+    )) \
+    X(SQLGetInfoW, ( \
+        SQLHDBC, SQLUSMALLINT, SQLPOINTER, SQLSMALLINT, SQLSMALLINT* \
+    )) \
+    X(SQLGetStmtAttr, ( \
+        SQLHSTMT, SQLINTEGER, SQLPOINTER, SQLINTEGER, SQLINTEGER* \
+    )) \
+    X(SQLGetTypeInfoW, (SQLHSTMT, SQLSMALLINT)) \
+    X(SQLNumParams, (SQLHSTMT, SQLSMALLINT*)) \
+    X(SQLNumResultCols, (SQLHSTMT, SQLSMALLINT*)) \
+    X(SQLParamData, (SQLHSTMT, SQLPOINTER*)) \
+    X(SQLPrepareW, (SQLHSTMT, SQLWCHAR*, SQLINTEGER)) \
+    X(SQLPutData, (SQLHSTMT, SQLPOINTER, SQLLEN)) \
+    X(SQLRowCount, (SQLHSTMT, SQLLEN*)) \
+    X(SQLSetConnectAttr, (SQLHDBC, SQLINTEGER, SQLPOINTER, SQLINTEGER)) \
+    X(SQLSetEnvAttr, (SQLHENV, SQLINTEGER, SQLPOINTER, SQLINTEGER)) \
+    X(SQLSetStmtAttr, (SQLHSTMT, SQLINTEGER, SQLPOINTER, SQLINTEGER)) \
+    X(SQLTablesW, ( \
+        SQLHSTMT, SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT, \
+        SQLWCHAR*, SQLSMALLINT, SQLWCHAR*, SQLSMALLINT \
+    ))
+
+#if LOAD_ODBC_LIBRARY
+
+struct OdbcLibraryStruct {
+    void* dl;  // from dlopen(), nullptr until the first OPEN-CONNECTION
+
+  #define X(name,params) \
+    SQLRETURN (SQL_API *name) params;
+    ODBC_FUNCTIONS(X)
+  #undef X
+};
+typedef struct OdbcLibraryStruct OdbcLibrary;
+
+OdbcLibrary g_odbc;
+
+static const char* g_odbc_library_names[] = {  // unixODBC only, see [2]
+  #if defined(__APPLE__)
+    "libodbc.2.dylib",
+    "/opt/homebrew/lib/libodbc.2.dylib",  // Homebrew on Apple Silicon
+    "/usr/local/lib/libodbc.2.dylib",  // Homebrew on Intel
+  #else
+    "libodbc.so.2",  // unixODBC
+    "libodbc.so.1",
+    "libodbc.so",
+  #endif
+    nullptr
+};
+
+static void Load_ODBC_Library(void) {
+    if (g_odbc.dl)
+        return;  // see [1]
+
+    void* dl = nullptr;
+    const char** name = g_odbc_library_names;
+    for (; dl == nullptr and *name != nullptr; ++name)
+        dl = dlopen(*name, RTLD_NOW | RTLD_GLOBAL);
+
+    if (dl == nullptr)
+        rebJumps (
+            "panic -[Couldn't load ODBC driver manager (e.g. unixODBC)]-"
+        );
+
+    // memcpy() avoids casting void* to a function pointer, which C and C++
+    // don't allow (though POSIX guarantees it works for dlsym()).
+    //
+  #define X(name,params) { \
+        void* symbol = dlsym(dl, #name); \
+        if (symbol == nullptr) { \
+            dlclose(dl); \
+            rebJumps ( \
+                "panic [-[ODBC library is missing]-", rebT(#name), "]" \
+            ); \
+        } \
+        memcpy(&g_odbc.name, &symbol, sizeof(symbol)); \
+    }
+    ODBC_FUNCTIONS(X)
+  #undef X
+
+    g_odbc.dl = dl;
+}
+
+#define ODBC_FUNCTION(name)  g_odbc.name
+
+#else
+
+#define ODBC_FUNCTION(name)  name
+
+#endif  // LOAD_ODBC_LIBRARY
+
+
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// ODBC CALL TRACE
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// While ODBC-TRACE has it on, every SQLXxx() call this file makes is logged
+// as a TraceRecord in a fixed-size ring, for seeing what the driver was asked
+// to do and how long it took (ODBC-TRACE-SNAPSHOT, ODBC-TRACE-DECODE).
+//
+// Each function name is #define'd to a macro that tests g_odbc_trace.on, and
+// makes the call directly when it's off.  So the cost of tracing when it's
+// off is one load and a branch per ODBC call.
+//
+// 1. The start time can't be passed as an argument alongside the call, since
+//    C doesn't say in what order arguments are evaluated.  The comma operator
+//    does, so Trace_Start() stashes the time for Trace_Call() to pick up.  It
+//    is thread-local, because worker threads make ODBC calls too.
+//
+// 2. Worker threads write records while the interpreter may be reading them.
+//    Each writer takes the next sequence number atomically, zeroes the seq of
+//    its slot while filling it in, and then sets it.  A reader only keeps a
+//    record whose seq is what it expected both before and after copying it.
+//    (The ring is only freed or resized once no worker threads are running.)
+//
+// 3. ROWS is the count for SQLRowCount(), and -1 for calls that don't count
+//    rows.  For SQLFetch() and SQLFetchScroll() it's the rows fetched: read
+//    from SQL_ATTR_ROWS_FETCHED_PTR if one is set, else 1 or 0 if the rowset
+//    is one row.  (A bigger rowset with no such pointer gives -1, as the
+//    count can't be known.)  Those SQLGetStmtAttr() calls aren't traced.
+//
+
+enum TracedFunctionEnum {
+  #define X(name,params) \
+    TRACE_##name,
+    ODBC_FUNCTIONS(X)
+  #undef X
+    MAX_TRACED_FUNCTION
+};
+typedef enum TracedFunctionEnum TracedFunction;
+
+static const char* g_traced_function_names[] = {
+  #define X(name,params) \
+    #name,
+    ODBC_FUNCTIONS(X)
+  #undef X
+    nullptr
+};
+
+struct TraceRecordStruct {  // the format of ODBC-TRACE-SNAPSHOT's BLOB!
+    uint64_t seq;  // 1 for the first call traced, 0 while written, see [2]
+    uint64_t start;  // from Now_Microseconds()
+    uint64_t handle;  // address of the handle the call was made with
+    int64_t rows;  // see [3]
+    uint32_t duration;  // microseconds
+    int16_t function;  // TracedFunction
+    int16_t rc;  // SQLRETURN
+};
+typedef struct TraceRecordStruct TraceRecord;
+
+#define DEFAULT_TRACE_SIZE  65536  // records in the ring (40 bytes each)
+
+struct OdbcTraceStruct {
+    bool on;
+    TraceRecord* ring;  // malloc()'d, see [2]
+    uint64_t size;  // number of records in the ring
+    uint64_t count;  // number of calls traced, only changed atomically
+    uint64_t flushed;  // seq of the last record ODBC-TRACE-SNAPSHOT:FLUSH took
+};
+typedef struct OdbcTraceStruct OdbcTrace;
+
+OdbcTrace g_odbc_trace;
+
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL __declspec(thread)
+#else
+    #define THREAD_LOCAL __thread
+#endif
+
+static THREAD_LOCAL uint64_t g_trace_started;  // see [1]
+
+static uint64_t Atomic_Increment(uint64_t* p) {
+  #if TO_WINDOWS
+    return cast(uint64_t, InterlockedIncrement64(p_cast(volatile LONG64*, p)));
+  #else
+    return __atomic_add_fetch(p, 1, __ATOMIC_ACQ_REL);
+  #endif
+}
+
+static uint64_t Atomic_Load(uint64_t* p) {
+  #if TO_WINDOWS
+    return cast(uint64_t,
+        InterlockedCompareExchange64(p_cast(volatile LONG64*, p), 0, 0)
+    );
+  #else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+  #endif
+}
+
+static void Atomic_Store(uint64_t* p, uint64_t value) {
+  #if TO_WINDOWS
+    InterlockedExchange64(p_cast(volatile LONG64*, p), cast(LONG64, value));
+  #else
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+  #endif
+}
+
+static void Trace_Start(void) {
+    g_trace_started = Now_Microseconds();
+}
+
+static int64_t Trace_Rows_Fetched(SQLHSTMT hstmt, SQLRETURN rc) {  // see [3]
+    if (rc == SQL_NO_DATA)
+        return 0;
+    if (not SQL_SUCCEEDED(rc))
+        return -1;
+
+    SQLULEN* fetched = nullptr;
+    SQLRETURN rc_attr = ODBC_FUNCTION(SQLGetStmtAttr)(
+        hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &fetched, 0, nullptr
+    );
+    if (SQL_SUCCEEDED(rc_attr) and fetched != nullptr)
+        return *fetched;
+
+    SQLULEN array_size = 1;
+    rc_attr = ODBC_FUNCTION(SQLGetStmtAttr)(
+        hstmt, SQL_ATTR_ROW_ARRAY_SIZE, &array_size, 0, nullptr
+    );
+    if (SQL_SUCCEEDED(rc_attr) and array_size == 1)
+        return 1;
+
+    return -1;
+}
+
+static SQLRETURN Trace_Call(
+    TracedFunction function,
+    SQLHANDLE handle,
+    SQLLEN* rows,  // only for SQLRowCount(), see [3]
+    SQLRETURN rc
+){
+    uint64_t duration = Now_Microseconds() - g_trace_started;
+
+    uint64_t seq = Atomic_Increment(&g_odbc_trace.count);
+    TraceRecord* r = &g_odbc_trace.ring[(seq - 1) % g_odbc_trace.size];
+
+    Atomic_Store(&r->seq, 0);  // see [2]
+    r->start = g_trace_started;
+    r->handle = cast(uintptr_t, handle);
+    if (rows)
+        r->rows = SQL_SUCCEEDED(rc) ? *rows : -1;
+    else if (function == TRACE_SQLFetch or function == TRACE_SQLFetchScroll)
+        r->rows = Trace_Rows_Fetched(handle, rc);
+    else
+        r->rows = -1;
+    r->duration = (duration > UINT32_MAX)
+        ? UINT32_MAX
+        : cast(uint32_t, duration);
+    r->function = function;
+    r->rc = rc;
+    Atomic_Store(&r->seq, seq);
+
+    return rc;
+}
+
+#define TRACE_ODBC_CALL(name,handle,rows,args) \
+    (g_odbc_trace.on \
+        ? (Trace_Start(), Trace_Call( \
+            TRACE_##name, (handle), (rows), ODBC_FUNCTION(name) args \
+        )) \
+        : ODBC_FUNCTION(name) args)
+
+// The handle is the first argument of most calls, but the second of those
+// that take a handle type.  ODBC_EXPAND() is for MSVC's old preprocessor,
+// which passes on __VA_ARGS__ as a single argument.
+//
+#define ODBC_EXPAND(x)  x
+#define ODBC_ARG_1_(a,...)  a
+#define ODBC_ARG_2_(a,b,...)  b
+
+#define TRACE_1(name,...) TRACE_ODBC_CALL(name, \
+    ODBC_EXPAND(ODBC_ARG_1_(__VA_ARGS__, ~)), nullptr, (__VA_ARGS__))
+
+#define TRACE_2(name,...) TRACE_ODBC_CALL(name, \
+    ODBC_EXPAND(ODBC_ARG_2_(__VA_ARGS__, ~)), nullptr, (__VA_ARGS__))
+
+#define SQLAllocHandle(...)  TRACE_2(SQLAllocHandle, __VA_ARGS__)
+#define SQLBindCol(...)  TRACE_1(SQLBindCol, __VA_ARGS__)
+#define SQLBindParameter(...)  TRACE_1(SQLBindParameter, __VA_ARGS__)
+#define SQLCancel(...)  TRACE_1(SQLCancel, __VA_ARGS__)
+#define SQLCloseCursor(...)  TRACE_1(SQLCloseCursor, __VA_ARGS__)
+#define SQLColAttribute(...)  TRACE_1(SQLColAttribute, __VA_ARGS__)
+#define SQLColAttributeW(...)  TRACE_1(SQLColAttributeW, __VA_ARGS__)
+#define SQLColumnsW(...)  TRACE_1(SQLColumnsW, __VA_ARGS__)
+#define SQLDescribeCol(...)  TRACE_1(SQLDescribeCol, __VA_ARGS__)
+#define SQLDescribeColW(...)  TRACE_1(SQLDescribeColW, __VA_ARGS__)
+#define SQLDisconnect(...)  TRACE_1(SQLDisconnect, __VA_ARGS__)
+#define SQLDriverConnectW(...)  TRACE_1(SQLDriverConnectW, __VA_ARGS__)
+#define SQLEndTran(...)  TRACE_2(SQLEndTran, __VA_ARGS__)
+#define SQLExecute(...)  TRACE_1(SQLExecute, __VA_ARGS__)
+#define SQLFetch(...)  TRACE_1(SQLFetch, __VA_ARGS__)
+#define SQLFetchScroll(...)  TRACE_1(SQLFetchScroll, __VA_ARGS__)
+#define SQLFreeHandle(...)  TRACE_2(SQLFreeHandle, __VA_ARGS__)
+#define SQLFreeStmt(...)  TRACE_1(SQLFreeStmt, __VA_ARGS__)
+#define SQLGetConnectAttr(...)  TRACE_1(SQLGetConnectAttr, __VA_ARGS__)
+#define SQLGetData(...)  TRACE_1(SQLGetData, __VA_ARGS__)
+#define SQLGetDiagRecW(...)  TRACE_2(SQLGetDiagRecW, __VA_ARGS__)
+#define SQLGetFunctions(...)  TRACE_1(SQLGetFunctions, __VA_ARGS__)
+#define SQLGetInfoW(...)  TRACE_1(SQLGetInfoW, __VA_ARGS__)
+#define SQLGetStmtAttr(...)  TRACE_1(SQLGetStmtAttr, __VA_ARGS__)
+#define SQLGetTypeInfoW(...)  TRACE_1(SQLGetTypeInfoW, __VA_ARGS__)
+#define SQLNumParams(...)  TRACE_1(SQLNumParams, __VA_ARGS__)
+#define SQLNumResultCols(...)  TRACE_1(SQLNumResultCols, __VA_ARGS__)
+#define SQLParamData(...)  TRACE_1(SQLParamData, __VA_ARGS__)
+#define SQLPrepareW(...)  TRACE_1(SQLPrepareW, __VA_ARGS__)
+#define SQLPutData(...)  TRACE_1(SQLPutData, __VA_ARGS__)
+#define SQLRowCount(hstmt,count) \
+    TRACE_ODBC_CALL(SQLRowCount, (hstmt), (count), (hstmt, count))
+#define SQLSetConnectAttr(...)  TRACE_1(SQLSetConnectAttr, __VA_ARGS__)
+#define SQLSetEnvAttr(...)  TRACE_1(SQLSetEnvAttr, __VA_ARGS__)
+#define SQLSetStmtAttr(...)  TRACE_1(SQLSetStmtAttr, __VA_ARGS__)
+#define SQLTablesW(...)  TRACE_1(SQLTablesW, __VA_ARGS__)
+
+
 // Only one SQLHENV is needed for all connections.  It is lazily initialized by
 // the ODBC module when needed.
 //
 SQLHENV henv = SQL_NULL_HANDLE;
 
 
+// CLOSE-STATEMENT resets the HSTMT and keeps it with the connection, so the
+// next OPEN-STATEMENT doesn't need SQLAllocHandle() (which some drivers make
+// a round trip to the server for).  POOL-ODBC changes the limit.
+//
+#define MAX_IDLE_HSTMTS 64
+#define DEFAULT_IDLE_HSTMTS 8
+
+
+//
+// !!! SQL introduced "NCHAR" for "Native Characters", which typically are
+// 2-bytes-per-character instead of just one.  As time has gone on, that's no
+// longer enough...and the UTF-8 encoding is the most pervasive way of storing
+// strings.  But it uses a varying number of bytes per character, which runs
+// counter to SQL's desire to use fixed-size-records.
+//
+// There is no clear endgame in the SQL world for what is going to be done
+// about this.  So many text strings (that might have emoji/etc.) get stored
+// as BLOB, which limits their searchability from within the SQL language
+// itself.  NoSQL databases have been edging into this space as a result.
+//
+// Since Ren-C makes the long bet on UTF-8, it started out by storing and
+// fetching UTF-8 from CHAR-based fields.  But some systems (e.g. Excel) seem
+// to not be returning UTF-8 when you request a CHAR() field via SQL_C_CHAR:
+//
+// https://github.com/metaeducation/rebol-odbc/issues/8
+//
+// Latin1 was tried, but it wasn't that either.  As a workaround, we let
+// you globally set the encoding/decoding method of CHAR fields.  (It can also
+// be overridden for a single connection, see CAPABILITIES-ODBC.)
+//
+typedef enum {
+    CHAR_COL_UTF8,
+    //
+    // !!! Should we offer a CHAR_COL_UCS2, which errors if you use any
+    // codepoints higher than 0xFFFF ?  (Right now that just uses UTF-16.)
+    //
+    CHAR_COL_UTF16,
+    CHAR_COL_LATIN1
+} CharColumnEncoding;
+
+// What a driver can do varies, so OPEN-CONNECTION asks it with SQLGetInfo()
+// and SQLGetFunctions() and keeps the answers with the connection.  Code that
+// has a faster way of doing something checks here before using it.  The
+// answers can be overridden with CAPABILITIES-ODBC:OVERRIDE.
+//
+struct CapabilitiesStruct {
+    bool any_order;  // SQL_GD_ANY_ORDER, SQLGetData() on columns in any order
+    bool param_arrays;  // SQL_ATTR_PARAMSET_SIZE > 1 (IMPORT-ODBC batches)
+    bool fetch_scroll;  // SQLFetchScroll() (COPY-ODBC:ABSOLUTE etc.)
+    bool type_names;  // check SQL_VARCHAR columns' type names (for SQLite)
+    bool has_char_encoding;  // else use the global g_char_column_encoding
+    CharColumnEncoding char_encoding;
+};
+typedef struct CapabilitiesStruct Capabilities;
+
+
 struct ConnectionStruct {  // indirect so SHUTDOWN* can find and kill open HDBC
     SQLHDBC hdbc;  // if SQL_NULL_HANDLE, cleanup already done
 
+    bool in_transaction;  // BEGIN-ODBC turned autocommit off
+    bool autocommit_was_on;  // what to restore when the transaction ends
+    SQLLEN batch_size;  // commit every N statements in transaction (0 = off)
+    SQLLEN batch_count;  // statements executed since last commit
+
+    Capabilities caps;
+
+    SQLHSTMT idle_hstmts[MAX_IDLE_HSTMTS];
+    int num_idle_hstmts;
+    int max_idle_hstmts;  // 0 means CLOSE-STATEMENT frees every HSTMT
+    SQLLEN num_hstmt_allocs;  // counts reported by POOL-ODBC
+    SQLLEN num_hstmt_reuses;
+    SQLLEN num_hstmt_frees;
+
+    struct ConnectionStruct* prev;
     struct ConnectionStruct* next;
 };
 typedef struct ConnectionStruct Connection;
 
 struct ParameterStruct {  // For binding parameters
     SQLULEN column_size;
-    SQLPOINTER buffer;
+    SQLPOINTER buffer;  // points at `scalar`, or into g_param_arena
     SQLULEN buffer_size;
     SQLLEN length;
+    Value* stream;  // big BLOB! sent with SQLPutData(), else nullptr
+
+    union {  // fixed-size values are stored here instead of allocated
+        unsigned char bit;
+        SQLUINTEGER ulong;
+        SQLINTEGER slong;
+        SQLUBIGINT ubigint;
+        SQLBIGINT sbigint;
+        SQLDOUBLE dbl;
+        DATE_STRUCT date;
+        TIME_STRUCT time;
+        TIMESTAMP_STRUCT stamp;
+    } scalar;
 };
 typedef struct ParameterStruct Parameter;
 
@@ -136,6 +692,8 @@ struct ColumnStruct {  // For describing a single column
     SQLSMALLINT precision;
     SQLSMALLINT nullable;
     bool is_unsigned;
+    CharColumnEncoding encoding;  // connection's when column was described
+    SQLULEN high_water;  // longest direct fetch so far, see Get_Data_Direct()
 };
 typedef struct ColumnStruct Column;
 
@@ -144,6 +702,7 @@ struct ColumnListStruct {  // For describing a list of columns
     Column* columns;  // if nullptr, cleanup already done
     SQLLEN num_columns;
 
+    struct ColumnListStruct* prev;
     struct ColumnListStruct* next;
 };
 typedef struct ColumnListStruct ColumnList;
@@ -155,11 +714,97 @@ typedef struct ColumnListStruct ColumnList;
 // but we need some lists to go through.
 //
 // The only time anything is actually removed from this list is when the
-// HANDLE! holding the reference is GC'd.
+// HANDLE! holding the reference is GC'd.  The lists are doubly linked so that
+// is O(1)...a server making many statements makes a ColumnList each time the
+// result columns change, and the GC frees them all one at a time.
 //
 Connection* g_all_connections = nullptr;
 ColumnList* g_all_columnlists = nullptr;
 
+static void Link_Connection(Connection* conn) {
+    conn->prev = nullptr;
+    conn->next = g_all_connections;
+    if (g_all_connections)
+        g_all_connections->prev = conn;
+    g_all_connections = conn;
+}
+
+static void Unlink_Connection(Connection* conn) {
+    if (conn->prev)
+        conn->prev->next = conn->next;
+    else
+        g_all_connections = conn->next;
+    if (conn->next)
+        conn->next->prev = conn->prev;
+}
+
+static void Link_Column_List(ColumnList* list) {
+    list->prev = nullptr;
+    list->next = g_all_columnlists;
+    if (g_all_columnlists)
+        g_all_columnlists->prev = list;
+    g_all_columnlists = list;
+}
+
+static void Unlink_Column_List(ColumnList* list) {
+    if (list->prev)
+        list->prev->next = list->next;
+    else
+        g_all_columnlists = list->next;
+    if (list->next)
+        list->next->prev = list->prev;
+}
+
+
+// Connection and ColumnList records are carved out of malloc()'d chunks, and
+// freed records go on a free list for the next allocation.  The chunks are
+// never given back: a HANDLE! may be GC'd after SHUTDOWN*, and its cleaner
+// has to have somewhere to put the record.
+//
+#define SLAB_RECORDS 32
+
+struct SlabStruct {
+    size_t record_size;
+    void* free_list;  // linked through the first pointer of each record
+    SQLLEN num_live;  // allocated and not freed yet (for HANDLES-ODBC)
+};
+typedef struct SlabStruct Slab;
+
+Slab g_connection_slab = { sizeof(Connection), nullptr, 0 };
+Slab g_columnlist_slab = { sizeof(ColumnList), nullptr, 0 };
+
+static void* Slab_Alloc(Slab* slab) {
+    if (slab->free_list == nullptr) {
+        char* chunk = cast(char*, malloc(slab->record_size * SLAB_RECORDS));
+        if (chunk == nullptr)
+            return nullptr;
+
+        size_t i;
+        for (i = 0; i != SLAB_RECORDS; ++i) {
+            void* record = chunk + i * slab->record_size;
+            *cast(void**, record) = slab->free_list;
+            slab->free_list = record;
+        }
+    }
+
+    void* record = slab->free_list;
+    slab->free_list = *cast(void**, record);
+    ++slab->num_live;
+    return record;
+}
+
+static void Slab_Free(Slab* slab, void* record) {
+    *cast(void**, record) = slab->free_list;
+    slab->free_list = record;
+    --slab->num_live;
+}
+
+// INSERT-ODBC has to find the Connection for a statement to count toward a
+// BEGIN-ODBC:BATCH commit.  That costs a lookup through the statement object,
+// so only do it if some connection is actually batching.
+//
+int g_num_batching_connections = 0;
+
 
 //=////////////////////////////////////////////////////////////////////////=//
 //
@@ -271,6 +916,18 @@ static void Force_Connection_Cleanup(Connection* conn) {
     if (conn->hdbc == SQL_NULL_HANDLE)
         return;  // already cleared out by CLOSE-CONNECTION or SHUTDOWN*
 
+    if (conn->batch_size != 0) {
+        conn->batch_size = 0;
+        --g_num_batching_connections;
+    }
+
+    while (conn->num_idle_hstmts != 0) {
+        --conn->num_idle_hstmts;
+        SQLFreeHandle(
+            SQL_HANDLE_STMT, conn->idle_hstmts[conn->num_idle_hstmts]
+        );
+    }
+
     SQLDisconnect(conn->hdbc);
     SQLFreeHandle(SQL_HANDLE_DBC, conn->hdbc);
     conn->hdbc = SQL_NULL_HANDLE;
@@ -282,56 +939,26 @@ static void Connection_Handle_Cleaner(void* p, size_t length) {
 
     Force_Connection_Cleanup(conn);
 
-    if (conn == g_all_connections)
-        g_all_connections = conn->next;
-    else {
-        Connection* temp = g_all_connections;
-        while (temp->next != conn)
-            temp = temp->next;
-        temp->next = temp->next->next;
-    }
-
-    rebFree(conn);
+    Unlink_Connection(conn);
+    Slab_Free(&g_connection_slab, conn);
 }
 
 
-//
-// !!! SQL introduced "NCHAR" for "Native Characters", which typically are
-// 2-bytes-per-character instead of just one.  As time has gone on, that's no
-// longer enough...and the UTF-8 encoding is the most pervasive way of storing
-// strings.  But it uses a varying number of bytes per character, which runs
-// counter to SQL's desire to use fixed-size-records.
-//
-// There is no clear endgame in the SQL world for what is going to be done
-// about this.  So many text strings (that might have emoji/etc.) get stored
-// as BLOB, which limits their searchability from within the SQL language
-// itself.  NoSQL databases have been edging into this space as a result.
-//
-// Since Ren-C makes the long bet on UTF-8, it started out by storing and
-// fetching UTF-8 from CHAR-based fields.  But some systems (e.g. Excel) seem
-// to not be returning UTF-8 when you request a CHAR() field via SQL_C_CHAR:
-//
-// https://github.com/metaeducation/rebol-odbc/issues/8
-//
-// Latin1 was tried, but it wasn't that either.  As a workaround, we let
-// you globally set the encoding/decoding method of CHAR fields.
-//
-typedef enum {
-    CHAR_COL_UTF8,
-    //
-    // !!! Should we offer a CHAR_COL_UCS2, which errors if you use any
-    // codepoints higher than 0xFFFF ?  (Right now that just uses UTF-16.)
-    //
-    CHAR_COL_UTF16,
-    CHAR_COL_LATIN1
-} CharColumnEncoding;
-
 // For now, default to the most conservative choice...which is to let the
 // driver/driver-manager do the translation from wide characters, but that is
 // less efficient than doing UTF-8
 //
 CharColumnEncoding g_char_column_encoding = CHAR_COL_UTF16;
 
+// The encoding for a connection's CHAR columns and TEXT! parameters, which
+// CAPABILITIES-ODBC:OVERRIDE may have set for just that connection.
+//
+static CharColumnEncoding Char_Encoding_Of(const Capabilities* caps) {
+    return caps->has_char_encoding
+        ? caps->char_encoding
+        : g_char_column_encoding;
+}
+
 
 //
 //  export /odbc-set-char-encoding: native [
@@ -363,6 +990,50 @@ DECLARE_NATIVE(ODBC_SET_CHAR_ENCODING)
 }
 
 
+// Fill in a connection's Capabilities (see CapabilitiesStruct).  A question
+// the driver can't answer is taken as the capability not being there, except
+// for param_arrays, which can't be asked about.
+//
+static void Probe_Capabilities(Connection* conn) {
+    Capabilities* caps = &conn->caps;
+
+    SQLUINTEGER getdata = 0;
+    SQLRETURN rc = SQLGetInfoW(
+        conn->hdbc, SQL_GETDATA_EXTENSIONS, &getdata, sizeof(getdata), nullptr
+    );
+    caps->any_order = SQL_SUCCEEDED(rc) and (getdata & SQL_GD_ANY_ORDER);
+
+    // No SQLGetInfo() type says if SQL_ATTR_PARAMSET_SIZE > 1 works, so
+    // parameter arrays are assumed until a driver refuses the PARAMSET_SIZE
+    // (IMPORT-ODBC then turns this off, see its [1]).
+    //
+    caps->param_arrays = true;
+
+    SQLUSMALLINT functions[SQL_API_ODBC3_ALL_FUNCTIONS_SIZE];
+    rc = SQLGetFunctions(conn->hdbc, SQL_API_ODBC3_ALL_FUNCTIONS, functions);
+    caps->fetch_scroll = SQL_SUCCEEDED(rc)
+        and SQL_FUNC_EXISTS(functions, SQL_API_SQLFETCHSCROLL);
+
+    SQLWCHAR name[64];
+    SQLSMALLINT size;  // in bytes
+    rc = SQLGetInfoW(conn->hdbc, SQL_DBMS_NAME, name, sizeof(name), &size);
+    if (not SQL_SUCCEEDED(rc))
+        caps->type_names = false;
+    else {
+        SQLSMALLINT max_size = sizeof(name) - sizeof(SQLWCHAR);
+        caps->type_names = rebUnboxLogic(
+            "did find", rebR(rebLengthedTextWide(
+                name, (size < max_size ? size : max_size) / sizeof(SQLWCHAR)
+            )),
+            "-[SQLite]-"
+        );
+    }
+
+    caps->has_char_encoding = false;  // follow ODBC-SET-CHAR-ENCODING
+    caps->char_encoding = CHAR_COL_UTF16;  // (unused until overridden)
+}
+
+
 //
 //  export /open-connection: native [
 //
@@ -394,6 +1065,10 @@ DECLARE_NATIVE(OPEN_CONNECTION)
 
     SQLRETURN rc;
 
+  #if LOAD_ODBC_LIBRARY
+    Load_ODBC_Library();  // panics if there's no driver manager
+  #endif
+
     // Lazily allocate the environment handle if not already allocated, and set
     // its version to ODBC3.  (We could track if we allocated it and free it
     // if the open fails, but for now just let SHUTDOWN* take care of it.)
@@ -465,14 +1140,26 @@ DECLARE_NATIVE(OPEN_CONNECTION)
     // Extension SHUTDOWN* might happen with HDBC handles outstanding, so we
     // need a level of indirection to enumerate them (ODBC does not offer it).
     //
-    Connection* conn = rebTryAlloc(Connection);
-    if (conn == nullptr)
+    Connection* conn = cast(Connection*, Slab_Alloc(&g_connection_slab));
+    if (conn == nullptr) {
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
         return "panic -[Could not allocate Connection tracking object]-";
-    rebUnmanageMemory(conn);
+    }
 
     conn->hdbc = hdbc;
-    conn->next = g_all_connections;
-    g_all_connections = conn;
+    conn->in_transaction = false;
+    conn->autocommit_was_on = true;
+    conn->batch_size = 0;
+    conn->batch_count = 0;
+    conn->num_idle_hstmts = 0;
+    conn->max_idle_hstmts = DEFAULT_IDLE_HSTMTS;
+    conn->num_hstmt_allocs = 0;
+    conn->num_hstmt_reuses = 0;
+    conn->num_hstmt_frees = 0;
+    Link_Connection(conn);
+
+    Probe_Capabilities(conn);
 
     Value* hdbc_value = rebHandle(
         conn, sizeof(Connection*), &Connection_Handle_Cleaner
@@ -487,10 +1174,28 @@ DECLARE_NATIVE(OPEN_CONNECTION)
 }
 
 
+// Get an HSTMT from the connection's pool (reset by Pool_Statement_Handle()),
+// or allocate a new one if the pool is empty.
 //
-//  export /open-statement: native [
-//
-//      return: [logic!]
+static SQLRETURN Take_Statement_Handle(Connection* conn, SQLHSTMT* hstmt) {
+    if (conn->num_idle_hstmts != 0) {
+        --conn->num_idle_hstmts;
+        *hstmt = conn->idle_hstmts[conn->num_idle_hstmts];
+        ++conn->num_hstmt_reuses;
+        return SQL_SUCCESS;
+    }
+
+    SQLRETURN rc = SQLAllocHandle(SQL_HANDLE_STMT, conn->hdbc, hstmt);
+    if (SQL_SUCCEEDED(rc))
+        ++conn->num_hstmt_allocs;
+    return rc;
+}
+
+
+//
+//  export /open-statement: native [
+//
+//      return: [logic!]
 //      connection [object!]
 //      statement [object!]
 //  ]
@@ -507,10 +1212,8 @@ DECLARE_NATIVE(OPEN_STATEMENT)
     );
     SQLHDBC hdbc = conn->hdbc;
 
-    SQLRETURN rc;
-
     SQLHSTMT hstmt;
-    rc = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    SQLRETURN rc = Take_Statement_Handle(conn, &hstmt);
     if (not SQL_SUCCEEDED(rc))
         return rebDelegate("panic", Error_ODBC_Dbc(hdbc));
 
@@ -522,26 +1225,93 @@ DECLARE_NATIVE(OPEN_STATEMENT)
 }
 
 
-// The buffer at *ParameterValuePtr SQLBindParameter binds to is deferred
-// buffer, and so is the StrLen_or_IndPtr. They need to be vaild over until
-// Execute or ExecDirect are called.
+// Variable-size parameter data (and the Parameter arrays themselves) comes
+// from a bump allocator, which is reset for the next execution instead of
+// freeing each buffer.  Memory is malloc()'d in blocks that never move, as
+// ODBC holds pointers into them until SQLExecute().  If one execution needed
+// more than one block, reset replaces them with a single block big enough for
+// all of it, so running the same INSERT-ODBC again settles into one block.
 //
-// Bound parameters are a Rebol value of incoming type.  These values inform
-// the dynamic allocation of a buffer for the parameter, pre-filling it with
-// the content of the value.
+// INSERT-ODBC and PARALLEL-ODBC both bind on the interpreter thread and can't
+// overlap, so they share g_param_arena and reset it before binding.  (A panic
+// while binding leaves it in use until the next reset, nothing leaks.)
 //
-SQLRETURN ODBC_BindParameter(
-    SQLHSTMT hstmt,
-    Parameter* p,
-    SQLUSMALLINT number,  // parameter number
-    const Value* v
-){
-    assert(number != 0);
+#define ARENA_BLOCK_SIZE (16 * 1024)
+#define ARENA_KEEP_SIZE (1024 * 1024)  // don't hold onto more after reset
+#define ARENA_ALIGN 8
+
+struct ArenaBlockStruct {
+    struct ArenaBlockStruct* prev;
+    size_t size;
+    size_t used;
+    double data[1];  // (for alignment) block's memory continues from here
+};
+typedef struct ArenaBlockStruct ArenaBlock;
+
+struct ArenaStruct {
+    ArenaBlock* block;  // most recent, earlier ones linked by `prev`
+    size_t total;  // bytes handed out since the last reset
+    size_t next_size;  // size for the first block after a reset
+};
+typedef struct ArenaStruct Arena;
+
+Arena g_param_arena = { nullptr, 0, 0 };
+
+static void* Arena_Alloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~cast(size_t, ARENA_ALIGN - 1);
+
+    ArenaBlock* b = arena->block;
+    if (b == nullptr or b->used + size > b->size) {
+        size_t block_size = ARENA_BLOCK_SIZE;
+        if (block_size < arena->next_size)
+            block_size = arena->next_size;
+        if (block_size < size)
+            block_size = size;
+
+        b = cast(ArenaBlock*,
+            malloc(offsetof(ArenaBlock, data) + block_size)
+        );
+        if (b == nullptr)
+            rebJumps ("panic -[Couldn't allocate parameter memory]-");
+        b->prev = arena->block;
+        b->size = block_size;
+        b->used = 0;
+        arena->block = b;
+        arena->next_size = 0;
+    }
+
+    void* result = cast(char*, b->data) + b->used;
+    b->used += size;
+    arena->total += size;
+    return result;
+}
+
+static void Free_Arena_Blocks(Arena* arena) {
+    while (arena->block) {
+        ArenaBlock* prev = arena->block->prev;
+        free(arena->block);
+        arena->block = prev;
+    }
+}
+
+static void Reset_Arena(Arena* arena) {
+    ArenaBlock* b = arena->block;
+    if (b != nullptr and (b->prev != nullptr or b->size > ARENA_KEEP_SIZE)) {
+        Free_Arena_Blocks(arena);
+        if (arena->total <= ARENA_KEEP_SIZE)
+            arena->next_size = arena->total;  // one block for all of it
+    }
+    else if (b != nullptr)
+        b->used = 0;
+
+    arena->total = 0;
+}
 
-    p->length = 0;  // ignored for most types
-    p->column_size = 0;  // also ignored for most types
-    Corrupt_If_Needful(p->buffer);  // required to be set by switch()
 
+// The SQL_C_XXX type a Rebol value is bound as, panicking if there isn't one.
+// PARALLEL-ODBC calls this to check all its parameters before allocating.
+//
+static SQLSMALLINT Parameter_C_Type(const Value* v) {
     // We don't expose integer mappings for Rebol data types in libRebol to
     // use in a switch() statement, so no:
     //
@@ -555,7 +1325,7 @@ SQLRETURN ODBC_BindParameter(
     //
     //   https://forum.rebol.info/t/540/4
     //
-    SQLSMALLINT c_type = rebUnboxInteger("switch:type @", v, "[",
+    return rebUnboxInteger("switch:type @", v, "[",
         //
         // We use quasiform ~null~ so it's easier to reify and degrade it.
         //
@@ -621,6 +1391,45 @@ SQLRETURN ODBC_BindParameter(
 
         "panic -[Non-SQL-mappable type used in parameter binding]-",
     "]");
+}
+
+
+// The buffer at *ParameterValuePtr SQLBindParameter binds to is deferred
+// buffer, and so is the StrLen_or_IndPtr. They need to be vaild over until
+// Execute or ExecDirect are called.
+//
+// Bound parameters are a Rebol value of incoming type.  These values inform
+// the dynamic allocation of a buffer for the parameter, pre-filling it with
+// the content of the value.  Fixed-size values go in the Parameter's own
+// `scalar`, and TEXT! and BLOB! data comes from the `arena`.
+//
+// BLOB!s of STREAM_BLOB_SIZE or more aren't copied into a buffer.  They are
+// bound as "data at execution" parameters, and SQLExecute() returns
+// SQL_NEED_DATA so Put_Streamed_Parameters() can send them in chunks.  That
+// way a big BLOB! doesn't need a second copy of itself in memory.  Only the
+// interpreter thread can do this (it reads the BLOB! with the API), so other
+// callers pass `may_stream` as false.
+//
+#define STREAM_BLOB_SIZE (1024 * 1024)
+#define STREAM_CHUNK_SIZE (64 * 1024)
+
+SQLRETURN ODBC_BindParameter(
+    SQLHSTMT hstmt,
+    Parameter* p,
+    SQLUSMALLINT number,  // parameter number
+    const Value* v,
+    CharColumnEncoding encoding,  // for TEXT! bound as SQL_C_CHAR
+    Arena* arena,
+    bool may_stream
+){
+    assert(number != 0);
+
+    p->length = 0;  // ignored for most types
+    p->column_size = 0;  // also ignored for most types
+    p->stream = nullptr;
+    Corrupt_If_Needful(p->buffer);  // required to be set by switch()
+
+    SQLSMALLINT c_type = Parameter_C_Type(v);
 
     SQLSMALLINT sql_type;
 
@@ -635,51 +1444,51 @@ SQLRETURN ODBC_BindParameter(
       case SQL_C_BIT: {  // [true false]
         sql_type = SQL_BIT;
         p->buffer_size = sizeof(unsigned char);
-        p->buffer = rebAllocN(char, p->buffer_size);
-        *cast(unsigned char*, p->buffer) = rebUnboxBoolean(rebQ(v));
+        p->buffer = &p->scalar.bit;
+        p->scalar.bit = rebUnboxBoolean(rebQ(v));
         break; }
 
       case SQL_C_ULONG: {  // unsigned INTEGER! in 32-bit positive range
         sql_type = SQL_INTEGER;
         p->buffer_size = sizeof(SQLUINTEGER);
-        p->buffer = rebAllocN(char, p->buffer_size);
-        *cast(SQLUINTEGER*, p->buffer) = rebUnboxInteger64(v);  // headroom
+        p->buffer = &p->scalar.ulong;
+        p->scalar.ulong = rebUnboxInteger64(v);  // headroom
         break; }
 
       case SQL_C_LONG: {  // signed INTEGER! in 32-bit negative range
         sql_type = SQL_INTEGER;
         p->buffer_size = sizeof(SQLINTEGER);  // use signed insertion
-        p->buffer = rebAllocN(char, p->buffer_size);
-        *cast(SQLINTEGER*, p->buffer) = rebUnboxInteger(v);  // signed 32-bit
+        p->buffer = &p->scalar.slong;
+        p->scalar.slong = rebUnboxInteger(v);  // signed 32-bit
         break; }
 
       case SQL_C_UBIGINT: {  // unsigned INTEGER! above 32-bit positive range
         sql_type = SQL_INTEGER;
         p->buffer_size = sizeof(SQLUBIGINT);  // !!! See notes RE: ODBC BIGINT
-        p->buffer = rebAllocN(char, p->buffer_size);
-        *cast(SQLUBIGINT*, p->buffer) = rebUnboxInteger64(v);
+        p->buffer = &p->scalar.ubigint;
+        p->scalar.ubigint = rebUnboxInteger64(v);
         break; }
 
       case SQL_C_SBIGINT: {  // signed INTEGER! below 32-bit negative range
         sql_type = SQL_INTEGER;
         p->buffer_size = sizeof(SQLBIGINT);  // !!! See notes RE: ODBC BIGINT
-        p->buffer = rebAllocN(char, p->buffer_size);
-        *cast(SQLBIGINT*, p->buffer) = rebUnboxInteger64(v);
+        p->buffer = &p->scalar.sbigint;
+        p->scalar.sbigint = rebUnboxInteger64(v);
         break; }
 
       case SQL_C_DOUBLE: {  // DECIMAL!
         sql_type = SQL_DOUBLE;
         p->buffer_size = sizeof(SQLDOUBLE);
-        p->buffer = rebAllocN(char, p->buffer_size);
-        *cast(SQLDOUBLE*, p->buffer) = rebUnboxDecimal(v);
+        p->buffer = &p->scalar.dbl;
+        p->scalar.dbl = rebUnboxDecimal(v);
         break; }
 
       case SQL_C_TYPE_TIME: {  // TIME! (fractions not preserved)
         sql_type = SQL_TYPE_TIME;
         p->buffer_size = sizeof(TIME_STRUCT);
-        p->buffer = rebAllocN(char, p->buffer_size);
+        p->buffer = &p->scalar.time;
 
-        TIME_STRUCT *time = cast(TIME_STRUCT*, p->buffer);
+        TIME_STRUCT *time = &p->scalar.time;
         time->hour = rebUnboxInteger("pick", v, "'hour");
         time->minute = rebUnboxInteger("pick", v, "'minute");
         time->second = rebUnboxInteger("pick", v, "'second");
@@ -688,9 +1497,9 @@ SQLRETURN ODBC_BindParameter(
       case SQL_C_TYPE_DATE: {  // DATE! with no time component
         sql_type = SQL_TYPE_DATE;
         p->buffer_size = sizeof(DATE_STRUCT);
-        p->buffer = rebAllocN(char, p->buffer_size);
+        p->buffer = &p->scalar.date;
 
-        DATE_STRUCT *date = cast(DATE_STRUCT*, p->buffer);
+        DATE_STRUCT *date = &p->scalar.date;
         date->year = rebUnboxInteger("pick", v, "'year");
         date->month = rebUnboxInteger("pick", v, "'month");
         date->day = rebUnboxInteger("pick", v, "'day");
@@ -699,7 +1508,7 @@ SQLRETURN ODBC_BindParameter(
       case SQL_C_TYPE_TIMESTAMP: {  // DATE! with a time component
         sql_type = SQL_TYPE_TIMESTAMP;
         p->buffer_size = sizeof(TIMESTAMP_STRUCT);
-        p->buffer = rebAllocN(char, p->buffer_size);
+        p->buffer = &p->scalar.stamp;
 
         Value* time = rebValue("pick", v, "'time");
         Value* second_and_fraction = rebValue("pick", time, "'second");
@@ -709,7 +1518,7 @@ SQLRETURN ODBC_BindParameter(
         //
         // https://github.com/metaeducation/rebol-odbc/issues/1
         //
-        TIMESTAMP_STRUCT *stamp = cast(TIMESTAMP_STRUCT*, p->buffer);
+        TIMESTAMP_STRUCT *stamp = &p->scalar.stamp;
         stamp->year = rebUnboxInteger("pick", v, "'year");
         stamp->month = rebUnboxInteger("pick", v, "'month");
         stamp->day = rebUnboxInteger("pick", v, "'day");
@@ -737,9 +1546,13 @@ SQLRETURN ODBC_BindParameter(
         //
       case SQL_C_CHAR: {  // TEXT! when target column is VARCHAR
         size_t encoded_size_no_term;
-        switch (g_char_column_encoding) {
+        switch (encoding) {
           case CHAR_COL_UTF8: {
-            unsigned char *utf8 = rebBytes(&encoded_size_no_term, v);
+            encoded_size_no_term = rebSpellInto(nullptr, 0, v);
+            char *utf8 = cast(char*,
+                Arena_Alloc(arena, encoded_size_no_term + 1)  // terminated
+            );
+            rebSpellInto(utf8, encoded_size_no_term, v);
             p->buffer = utf8;
             break; }
 
@@ -756,7 +1569,11 @@ SQLRETURN ODBC_BindParameter(
                          "to integer! ch"
                     "]"
             );
-            unsigned char *latin1 = rebBytes(&encoded_size_no_term, temp);
+            encoded_size_no_term = rebUnbox("length of", temp);
+            unsigned char *latin1 = cast(unsigned char*,
+                Arena_Alloc(arena, encoded_size_no_term)
+            );
+            rebBytesInto(latin1, encoded_size_no_term, temp);
             rebRelease(temp);
             p->buffer = latin1;
             break; }
@@ -787,7 +1604,9 @@ SQLRETURN ODBC_BindParameter(
         // codepoints > 0xFFFF are used.
         //
         unsigned int num_wchars_no_term = rebSpellIntoWide(nullptr, 0, v);
-        SQLWCHAR *chars = rebAllocN(SQLWCHAR, num_wchars_no_term + 1);
+        SQLWCHAR *chars = cast(SQLWCHAR*,
+            Arena_Alloc(arena, sizeof(SQLWCHAR) * (num_wchars_no_term + 1))
+        );
         unsigned int check = rebSpellIntoWide(chars, num_wchars_no_term, v);
         assert(check == num_wchars_no_term);
         UNUSED(check);
@@ -802,10 +1621,21 @@ SQLRETURN ODBC_BindParameter(
     //    column capacity, not necessarily the data size.
 
       case SQL_C_BINARY: {  // BLOB!
-        size_t size;
-        unsigned char *bytes = rebBytes(&size, v);
-
         sql_type = SQL_VARBINARY;
+
+        size_t size = rebUnbox("length of", v);
+        if (may_stream and size >= STREAM_BLOB_SIZE) {
+            p->stream = rebValue(rebQ(v));  // same BLOB!, not a copy
+            p->buffer = nullptr;
+            p->buffer_size = 0;
+            p->length = SQL_LEN_DATA_AT_EXEC(cast(SQLLEN, size));
+            p->column_size = size;
+            break;
+        }
+
+        unsigned char *bytes = cast(unsigned char*, Arena_Alloc(arena, size));
+        rebBytesInto(bytes, size, v);
+
         p->buffer = bytes;
         p->buffer_size = size * sizeof(char);
         p->length = size;
@@ -825,7 +1655,9 @@ SQLRETURN ODBC_BindParameter(
         sql_type,  // ParameterType
         p->column_size,  // ColumnSize
         0,  // DecimalDigits
-        p->buffer,  // ParameterValuePtr
+        p->stream  // ParameterValuePtr (SQLParamData() gives back if stream)
+            ? p_cast(SQLPOINTER, cast(uintptr_t, number))
+            : p->buffer,
         p->buffer_size,  // BufferLength
         &p->length  // StrLen_Or_IndPtr
     );
@@ -834,6 +1666,75 @@ SQLRETURN ODBC_BindParameter(
 }
 
 
+// After SQLExecute() returns SQL_NEED_DATA, send each streamed parameter in
+// chunks.  Returns what the final SQLParamData() does, which is the result of
+// the execution.
+//
+// 1. The statement would be left waiting for data if we just returned on a
+//    failure, and the next SQLPrepare() or SQLExecute() on it would fail with
+//    HY010--even after it went back to the connection's idle pool.  So it is
+//    canceled.  The error is made first, as SQLCancel() clears diagnostics.
+//
+// 2. The BLOB! is only kept alive by the Parameter's API handle, not locked,
+//    so it could be changed by the time its data is sent.
+//
+static SQLRETURN Put_Streamed_Parameters(SQLHSTMT hstmt, Parameter* params) {
+    SQLRETURN rc;
+    SQLPOINTER token;
+    while ((rc = SQLParamData(hstmt, &token)) == SQL_NEED_DATA) {
+        Parameter* p = &params[cast(uintptr_t, token) - 1];
+        assert(p->stream);
+
+        size_t total = p->column_size;
+        size_t offset = 0;
+        while (offset < total) {
+            size_t chunk = total - offset;
+            if (chunk > STREAM_CHUNK_SIZE)
+                chunk = STREAM_CHUNK_SIZE;
+
+            size_t size;
+            unsigned char* bytes = rebBytes(&size,
+                "copy:part skip", p->stream, rebI(offset), rebI(chunk)
+            );
+            if (size != chunk) {  // see [2]
+                rebFree(bytes);
+                SQLCancel(hstmt);
+                rebJumps (
+                    "panic -[BLOB! parameter changed while being sent]-"
+                );
+            }
+            rc = SQLPutData(hstmt, bytes, size);
+            rebFree(bytes);
+            if (not SQL_SUCCEEDED(rc))
+                goto cancel;
+
+            offset += chunk;
+        }
+    }
+
+    if (SQL_SUCCEEDED(rc) or rc == SQL_NO_DATA)
+        return rc;
+
+  cancel: {  // see [1]
+    Value* error = Error_ODBC_Stmt(hstmt);
+    SQLCancel(hstmt);
+    rebJumps ("panic", error);
+  }
+}
+
+
+// Parameter buffers need to live until SQLExecute() is done with them.  The
+// memory is in g_param_arena, so this just releases streamed BLOB!s.
+//
+static void Free_Parameters(Parameter* params, SQLLEN num_params) {
+    SQLLEN n;
+    for (n = 0; n != num_params; ++n) {
+        if (params[n].stream != nullptr)
+            rebRelease(params[n].stream);
+    }
+}
+
+
 SQLRETURN Get_ODBC_Catalog(
     SQLHSTMT hstmt,
     Value* block
@@ -916,17 +1817,21 @@ SQLRETURN Get_ODBC_Catalog(
 
 #define COLUMN_TITLE_SIZE 255
 
-static void Force_ColumnList_Cleanup(ColumnList* list) {
-    if (list->columns == nullptr)
-        return;  // already freed e.g. by SHUTDOWN*
-
+static void Free_Columns(Column* columns, SQLLEN num_columns) {
     SQLSMALLINT col_num;
-    for (col_num = 0; col_num < list->num_columns; ++col_num) {
-        Column* col = &list->columns[col_num];
+    for (col_num = 0; col_num < num_columns; ++col_num) {
+        Column* col = &columns[col_num];
         rebFreeOpt(col->buffer);
         rebRelease(col->title);
     }
-    rebFree(list->columns);
+    rebFree(columns);
+}
+
+static void Force_ColumnList_Cleanup(ColumnList* list) {
+    if (list->columns == nullptr)
+        return;  // already freed e.g. by SHUTDOWN*
+
+    Free_Columns(list->columns, list->num_columns);
     list->columns = nullptr;
 }
 
@@ -936,16 +1841,8 @@ static void Column_List_Handle_Cleaner(void* p, size_t length) {
 
     Force_ColumnList_Cleanup(list);
 
-    if (list == g_all_columnlists)
-        g_all_columnlists = list->next;
-    else {
-        ColumnList* temp = g_all_columnlists;
-        while (temp->next != list)
-            temp = temp->next;
-        temp->next = temp->next->next;
-    }
-
-    rebFree(list);
+    Unlink_Column_List(list);
+    Slab_Free(&g_columnlist_slab, list);
 }
 
 
@@ -955,7 +1852,8 @@ static void Column_List_Handle_Cleaner(void* p, size_t length) {
 void Describe_ODBC_Results(
     SQLHSTMT hstmt,
     int num_columns,
-    Column* columns
+    Column* columns,
+    const Capabilities* caps
 ){
     SQLSMALLINT column_index;
     for (column_index = 1; column_index <= num_columns; ++column_index) {
@@ -1008,9 +1906,11 @@ void Describe_ODBC_Results(
 
         // We *SHOULD* be able to rely on the `sql_type` that SQLDescribeCol()
         // gives us, but SQLite returns SQL_VARCHAR for other column types.
-        // As a workaround that shouldn't do any harm on non-SQLite databases,
-        // we double-check the string name of the column; and use the string
-        // name to override if it isn't actually a VARCHAR:
+        // As a workaround (only done if the connection's DBMS is SQLite, or
+        // it was asked for with CAPABILITIES-ODBC:OVERRIDE) we double-check
+        // the string name of the column; and use the string name to override
+        // if it isn't actually a VARCHAR:
+        // https://stackoverflow.com/q/58438456
         // https://stackoverflow.com/a/58438457/
         //
         // Additionally, it seems that even if you call `SQLColAttribute` and
@@ -1019,8 +1919,7 @@ void Describe_ODBC_Results(
         // type names are really just ASCII:
         // https://github.com/metaeducation/rebol-odbc/issues/7
         //
-      #if defined(USE_SQLITE_DESCRIBECOL_WORKAROUND)
-        if (col->sql_type == SQL_VARCHAR) {
+        if (caps->type_names and col->sql_type == SQL_VARCHAR) {
             SQLWCHAR type_name[32];  // Note: `typename` is a C++ keyword
             SQLSMALLINT type_name_len;
             rc = SQLColAttributeW(  // See above for why the "W" version used
@@ -1062,7 +1961,10 @@ void Describe_ODBC_Results(
             );
             rebRelease(type_name_rebval);
         }
-      #endif
+
+        col->encoding = Char_Encoding_Of(caps);
+
+        col->high_water = 0;
 
         // With the SQL_type hopefully accurate, pick an implementation type
         // to use when querying for columns of that type.
@@ -1150,7 +2052,7 @@ void Describe_ODBC_Results(
 
           case SQL_CHAR:
           case SQL_VARCHAR:
-            if (g_char_column_encoding == CHAR_COL_UTF16)
+            if (col->encoding == CHAR_COL_UTF16)
                 goto decode_as_utf16;  // !!! see notes on CHAR_COL_UTF16
 
             col->c_type = SQL_C_CHAR;
@@ -1174,7 +2076,7 @@ void Describe_ODBC_Results(
             break;
 
           case SQL_LONGVARCHAR:
-            if (g_char_column_encoding == CHAR_COL_UTF16)
+            if (col->encoding == CHAR_COL_UTF16)
                 goto decode_as_long_utf16;  // !!! see notes on CHAR_COL_UTF16
 
             col->c_type = SQL_C_CHAR;
@@ -1220,653 +2122,5628 @@ void Describe_ODBC_Results(
 }
 
 
+//=////////////////////////////////////////////////////////////////////////=//
 //
-//  export /insert-odbc: native [
+// RAW ROW FETCHING (NO REBOL API, SAFE ON WORKER THREADS)
 //
-//  "Executes SQL statements (prepare on first pass, executes conservatively)"
+//=////////////////////////////////////////////////////////////////////////=//
 //
-//      return: [
-//          integer!    "Row count for row change"
-//          block!      "Column title BLOCK! for selects"
-//      ]
-//      statement [object!]
-//      sql "Dialect beginning with TABLES, COLUMNS, TYPES, or SQL STRING!"
-//          [block!]
-//  ]
+// COPY-ODBC interleaves SQLFetch()/SQLGetData() with making Rebol values.  To
+// overlap the two, rows can be fetched into a RowBlock: a malloc()'d byte
+// buffer holding each cell's data, with a parallel array of lengths and
+// offsets.  Filling a RowBlock only uses ODBC calls, so it can be done on a
+// worker thread while the interpreter converts a previously filled block.
 //
-DECLARE_NATIVE(INSERT_ODBC)
-{
-    INCLUDE_PARAMS_OF_INSERT_ODBC;
 
-    SQLHSTMT hstmt = rebUnboxHandle(
-        SQLHSTMT*, "ensure handle! statement.hstmt"
-    );
+struct ByteBufferStruct {  // growable malloc() memory, not rebAlloc()
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+};
+typedef struct ByteBufferStruct ByteBuffer;
 
-    SQLRETURN rc;
-    rc = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);  // !!! check rc?
-    rc = SQLCloseCursor(hstmt);  // !!! check rc?
-    UNUSED(rc);
+static bool Byte_Buffer_Reserve(ByteBuffer* b, size_t more) {
+    if (b->size + more <= b->capacity)
+        return true;
 
-    //=//// MAKE SQL REQUEST FROM DIALECTED SQL BLOCK /////////////////////=//
-    //
-    // The block passed in is used to form a query.
+    size_t capacity = b->capacity == 0 ? 4096 : b->capacity;
+    while (capacity < b->size + more)
+        capacity *= 2;
 
-    bool use_cache = false;
+    unsigned char* data = cast(unsigned char*, realloc(b->data, capacity));
+    if (data == nullptr)
+        return false;
 
-    bool get_catalog = rebUnboxBoolean(
-        "switch:type first sql [",
-            "lit-word?/ ['true]",  // like Rebol2: 'tables, 'columns, 'types
-            "text! ['false]",
-        "] else [",
-            "panic [",
-                "-[SQL dialect must start with WORD! or TEXT! value:]- @sql"
-            "]",
-        "]"
-    );
+    b->data = data;
+    b->capacity = capacity;
+    return true;
+}
 
-    if (get_catalog) {
-        Value* sql = rebValue("sql");
-        rc = Get_ODBC_Catalog(hstmt, sql);
-        rebRelease(sql);
-    }
-    else {
-        // Prepare/Execute statement, when first element in the block is a
-        // (statement) string
+static void Free_Byte_Buffer(ByteBuffer* b) {
+    free(b->data);
+    b->data = nullptr;
+    b->size = b->capacity = 0;
+}
 
-        // Compare with previously prepared statement, and if not the same,
-        // then prepare a new statement.
-        //
-        use_cache = rebUnboxLogic(
-            "equal? (first sql) ensure [<null> text!] statement.string"
-        );
 
-        SQLLEN sql_index = 1;
+struct RowBlockStruct {
+    SQLSMALLINT num_columns;
+    const SQLUSMALLINT* column_numbers;  // ascending, or nullptr for all
+    SQLLEN num_rows;
+    SQLLEN capacity_rows;
+    SQLLEN* lengths;  // num_columns per row, SQL_NULL_DATA for NULL
+    size_t* offsets;  // where each cell's data starts in `bytes`
+    ByteBuffer bytes;
+
+    SQLRETURN rc;  // SQL_SUCCESS if more rows may follow, else SQL_NO_DATA
+    const char* failure;  // non-ODBC problem (no diagnostic on the HSTMT)
+};
+typedef struct RowBlockStruct RowBlock;
+
+static void Init_Row_Block(RowBlock* block, SQLSMALLINT num_columns) {
+    block->num_columns = num_columns;
+    block->column_numbers = nullptr;
+    block->num_rows = 0;
+    block->capacity_rows = 0;
+    block->lengths = nullptr;
+    block->offsets = nullptr;
+    block->bytes.data = nullptr;
+    block->bytes.size = block->bytes.capacity = 0;
+    block->rc = SQL_SUCCESS;
+    block->failure = nullptr;
+}
 
-        if (not use_cache) {
-            SQLWCHAR *sql_string = rebSpellWide("first sql");
+static void Free_Row_Block(RowBlock* block) {
+    free(block->lengths);
+    free(block->offsets);
+    Free_Byte_Buffer(&block->bytes);
 
-            rc = SQLPrepareW(
-                hstmt,
-                sql_string,
-                SQL_NTS  // Null-Terminated String
-            );
-            if (not SQL_SUCCEEDED(rc))
-                return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+    const SQLUSMALLINT* column_numbers = block->column_numbers;
+    Init_Row_Block(block, block->num_columns);
+    block->column_numbers = column_numbers;
+}
 
-            rebFree(sql_string);
+// ODBC column number (1-based) of the block's nth cell in each row.
+//
+static SQLUSMALLINT Row_Block_Column_Number(
+    const RowBlock* block,
+    SQLSMALLINT n
+){
+    if (block->column_numbers)
+        return block->column_numbers[n];
+    return cast(SQLUSMALLINT, n + 1);
+}
 
-            // Remember statement string handle, but keep a copy since it
-            // may be mutated by the user.
-            //
-            // !!! Could re-use value with existing series if read only
-            //
-            rebElide("statement.string: copy first sql");
-        }
+static bool Row_Block_Reserve_Row(RowBlock* block) {
+    if (block->num_rows < block->capacity_rows)
+        return true;
 
-        // The SQL string may contain ? characters, which indicates that it is
-        // a parameterized query.  The separation of the parameters into a
-        // different quarantined part of the query is to protect against SQL
-        // injection.
+    SQLLEN capacity = (block->capacity_rows == 0)
+        ? 64
+        : block->capacity_rows * 2;
+    size_t cells = cast(size_t, capacity) * block->num_columns;
 
-        SQLLEN num_params = rebUnbox("length of sql") - sql_index;
+    SQLLEN* lengths = cast(SQLLEN*,
+        realloc(block->lengths, cells * sizeof(SQLLEN))
+    );
+    if (lengths == nullptr)
+        return false;
+    block->lengths = lengths;
 
-        ++sql_index;
+    size_t* offsets = cast(size_t*,
+        realloc(block->offsets, cells * sizeof(size_t))
+    );
+    if (offsets == nullptr)
+        return false;
+    block->offsets = offsets;
 
-        Parameter* params = nullptr;
-        if (num_params != 0) {
-            params = rebAllocN(Parameter, num_params);
+    block->capacity_rows = capacity;
+    return true;
+}
 
-            SQLLEN n;
-            for (n = 0; n < num_params; ++n, ++sql_index) {
-                Value* value = rebValue("pick sql", rebI(sql_index));
-                rc = ODBC_BindParameter(
-                    hstmt,
-                    &params[n],
-                    n + 1,
-                    value
-                );
-                rebRelease(value);
-                if (not SQL_SUCCEEDED(rc))
-                    return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
-            }
+
+// Get the rest of a cell that didn't fit in its buffer_size (see [2] of
+// Fetch_Cell_Raw()), appending to what the first SQLGetData() wrote.
+//
+static SQLRETURN Fetch_Cell_Rest(
+    SQLHSTMT hstmt,
+    SQLUSMALLINT column_index,
+    const Column* col,
+    size_t term,  // size of the terminator the driver adds
+    RowBlock* block,
+    SQLLEN* len  // in: from the first SQLGetData(), out: the whole length
+){
+    ByteBuffer* bytes = &block->bytes;  // cell starts at bytes->size
+
+    size_t size = col->buffer_size - term;  // data gotten so far
+    SQLLEN remaining = (*len == SQL_NO_TOTAL)
+        ? SQL_NO_TOTAL
+        : *len - cast(SQLLEN, size);
+
+    while (true) {
+        size_t more = (remaining == SQL_NO_TOTAL)
+            ? (size < 4096 ? 4096 : size)  // doubles the size each time
+            : cast(size_t, remaining);
+        if (not Byte_Buffer_Reserve(bytes, size + more + term)) {
+            block->failure = "Out of memory fetching ODBC rows";
+            return SQL_ERROR;
         }
 
-        // Execute statement, but don't check result code until after the
-        // parameters and their data buffers have been freed.
-        //
-        rc = SQLExecute(hstmt);
+        SQLLEN got;  // what remained before this call, or SQL_NO_TOTAL
+        SQLRETURN rc = SQLGetData(
+            hstmt,
+            column_index,
+            col->c_type,
+            bytes->data + bytes->size + size,
+            more + term,  // BufferLength counts the terminator
+            &got
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rc;
 
-        if (num_params != 0) {
-            SQLLEN n;
-            for (n = 0; n != num_params; ++n) {
-                if (params[n].buffer != nullptr)
-                    rebFree(params[n].buffer);
-            }
-            rebFree(params);
+        if (got != SQL_NO_TOTAL and cast(size_t, got) <= more) {
+            size += got;  // the rest of the data fit
+            break;
         }
 
-        switch (rc) {
-          case SQL_SUCCESS:
-          case SQL_SUCCESS_WITH_INFO:
-            break;
+        size += more;  // truncated again, so the driver filled the buffer
+        remaining = (got == SQL_NO_TOTAL)
+            ? SQL_NO_TOTAL
+            : got - cast(SQLLEN, more);
+    }
 
-          case SQL_NO_DATA:  // UPDATE, INSERT, or DELETE affecting no rows
-            break;
+    *len = size;
+    return SQL_SUCCESS;
+}
 
-          case SQL_NEED_DATA:
-            assert(!"SQL_NEED_DATA seen...only happens w/data @ execution");
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
 
-          case SQL_STILL_EXECUTING:
-            assert(!"SQL_STILL_EXECUTING seen...only w/async calls");
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+// Get one cell with SQLGetData() into the block's bytes, following the same
+// rules as COPY-ODBC: fixed-size and character columns have a buffer_size
+// from Describe_ODBC_Results(), while variable-size binary columns (which
+// have buffer_size of 0) are sized with a first SQLGetData() call.
+//
+// 1. Cells are aligned so the fixed-size types (SQLDOUBLE, DATE_STRUCT...)
+//    can be read in place from the buffer.
+//
+// 2. A CHAR, WCHAR or BINARY value too long for its buffer comes back cut,
+//    with SQL_SUCCESS_WITH_INFO and a len of the whole value (or NO_TOTAL),
+//    e.g. a LONGVARCHAR over 32K or an NVARCHAR(MAX).  The rest is gotten
+//    with more SQLGetData() calls appended to the cell, as Get_Data_Direct()
+//    does for COPY-ODBC, so the cell may be bigger than buffer_size.
+//
+static SQLRETURN Fetch_Cell_Raw(
+    SQLHSTMT hstmt,
+    SQLUSMALLINT column_index,
+    const Column* col,
+    RowBlock* block,
+    size_t cell
+){
+    ByteBuffer* bytes = &block->bytes;
 
-          case SQL_ERROR:
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+    bytes->size = (bytes->size + 7) & ~cast(size_t, 7);  // see [1]
+    if (not Byte_Buffer_Reserve(bytes, col->buffer_size)) {
+        block->failure = "Out of memory fetching ODBC rows";
+        return SQL_ERROR;
+    }
 
-          case SQL_INVALID_HANDLE:
-            assert(!"SQL_INVALID_HANDLE seen...should never happen");
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+    SQLLEN len;
+    SQLRETURN rc;
+    size_t cell_size = col->buffer_size;  // how much of `bytes` cell takes
 
-        #if ODBCVER >= 0x0380
-          case SQL_PARAM_DATA_AVAILABLE:
-            assert(!"SQL_PARAM_DATA_AVAILABLE seen...only in ODBC 3.8");
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
-        #endif
+    if (col->buffer_size != 0) {
+        rc = SQLGetData(
+            hstmt,
+            column_index,
+            col->c_type,
+            bytes->data + bytes->size,
+            col->buffer_size,
+            &len
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rc;
+
+        size_t term = 0;  // size of terminator the driver adds, if any
+        if (col->c_type == SQL_C_CHAR)
+            term = 1;
+        else if (col->c_type == SQL_C_WCHAR)
+            term = sizeof(SQLWCHAR);
+
+        bool sized = (term != 0 or col->c_type == SQL_C_BINARY);
+        if (
+            sized and len != SQL_NULL_DATA
+            and (
+                len == SQL_NO_TOTAL
+                or cast(size_t, len) > col->buffer_size - term
+            )
+        ){
+            rc = Fetch_Cell_Rest(  // see [2]
+                hstmt, column_index, col, term, block, &len
+            );
+            if (rc != SQL_SUCCESS)
+                return rc;
+            if (cast(size_t, len) + term > cell_size)
+                cell_size = len + term;
         }
     }
+    else {
+        char dummy[DUMMY_BUFFER_SIZE];  // g_dummy_buffer is not thread-safe
+        rc = SQLGetData(hstmt, column_index, col->c_type, dummy, 0, &len);
+        if (not SQL_SUCCEEDED(rc))
+            return rc;
 
-    //=//// RETURN RECORD COUNT IF NO RESULT ROWS /////////////////////////=//
-    //
-    // Insert or Update or Delete statements do not return records, and this
-    // is indicated by a 0 count for columns in the return result.
+        if (len == SQL_NO_TOTAL) {
+            block->failure = "ODBC gave SQL_NO_TOTAL for var-size field";
+            return SQL_ERROR;
+        }
 
-    SQLSMALLINT num_columns;
-    rc = SQLNumResultCols(hstmt, &num_columns);
-    if (not SQL_SUCCEEDED(rc))
-        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+        if (len != SQL_NULL_DATA and len != 0) {
+            if (not Byte_Buffer_Reserve(bytes, len + 1)) {
+                block->failure = "Out of memory fetching ODBC rows";
+                return SQL_ERROR;
+            }
 
-    if (num_columns == 0) {
-        SQLLEN num_rows;
-        rc = SQLRowCount(hstmt, &num_rows);
-        if (not SQL_SUCCEEDED(rc))
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+            SQLLEN len_check;
+            rc = SQLGetData(
+                hstmt,
+                column_index,
+                col->c_type,
+                bytes->data + bytes->size,
+                len,  // amount of space in buffer
+                &len_check
+            );
+            if (rc != SQL_SUCCESS)
+                return rc == SQL_SUCCESS_WITH_INFO ? SQL_ERROR : rc;
 
-        return rebInteger(num_rows);
+            assert(len_check == len);
+        }
     }
 
-    //=//// RETURN CACHED TITLES BLOCK OR REBUILD IF NEEDED ///////////////=//
-    //
-    // A SELECT statement or a request for a catalog listing of tables or
-    // other database features will generate rows.  However, this routine only
-    // returns the titles of the columns.  COPY-ODBC is used to actually get
-    // the values.
-    //
-    // !!! The reason it is factored this way might have dealt with the idea
-    // that you could want to have different ways of sub-querying the results
-    // vs. having all the records spewed to you.  The results might also be
-    // very large so you don't want them all in memory at once.  The COPY-ODBC
-    // routine does this.
+    block->lengths[cell] = len;
+    block->offsets[cell] = bytes->size;
 
-    if (use_cache)
-        return rebValue("ensure block! statement.titles");
+    if (len != SQL_NULL_DATA) {
+        if (col->buffer_size != 0)
+            bytes->size += cell_size;
+        else
+            bytes->size += len;
+    }
 
-    Value* old_columns_value = rebValue(
-        "ensure [<null> handle!] statement.columns"
-    );
-    if (old_columns_value) {
-        //
-        // Because we have the HANDLE! here we could go ahead and free the
-        // columnlist itself (not just the columns), but that would mean the
-        // GC of the HANDLE! would need to detect nulls.  Just let the GC do
-        // the free.
-        //
-        ColumnList* old_list = rebUnboxHandle(ColumnList*, old_columns_value);
-        Force_ColumnList_Cleanup(old_list);
-        rebRelease(old_columns_value);
+    return SQL_SUCCESS;
+}
+
+
+// Fetch up to max_rows rows (-1 for all of them) into a block, replacing what
+// it had.  Leaves block->rc as SQL_NO_DATA if the result set was exhausted,
+// SQL_SUCCESS if there may be more rows, or the failing SQLRETURN.
+//
+static void Fetch_Rows_Raw(
+    SQLHSTMT hstmt,
+    const Column* columns,
+    RowBlock* block,
+    SQLLEN max_rows
+){
+    block->num_rows = 0;
+    block->bytes.size = 0;
+    block->rc = SQL_SUCCESS;
+    block->failure = nullptr;
+
+    for (; block->num_rows != max_rows; ++block->num_rows) {
+        SQLRETURN rc = SQLFetch(hstmt);
+        if (rc == SQL_NO_DATA) {
+            block->rc = SQL_NO_DATA;
+            return;
+        }
+        if (not SQL_SUCCEEDED(rc)) {  // SQL_SUCCESS_WITH_INFO info ignored
+            block->rc = rc;
+            return;
+        }
+
+        if (not Row_Block_Reserve_Row(block)) {
+            block->rc = SQL_ERROR;
+            block->failure = "Out of memory fetching ODBC rows";
+            return;
+        }
+
+        size_t cell = cast(size_t, block->num_rows) * block->num_columns;
+
+        SQLSMALLINT n;
+        for (n = 0; n != block->num_columns; ++n) {
+            SQLUSMALLINT number = Row_Block_Column_Number(block, n);
+            rc = Fetch_Cell_Raw(
+                hstmt, number, &columns[number - 1], block, cell + n
+            );
+            if (rc != SQL_SUCCESS) {
+                block->rc = rc;
+                return;
+            }
+        }
     }
+}
 
-    ColumnList* list = rebAlloc(ColumnList);
-    rebUnmanageMemory(list);
 
-    list->columns = rebAllocN(Column, num_columns);
-    rebUnmanageMemory(list->columns);
+// COPY-ODBC:PREFETCH converts one RowBlock while a worker thread fetches the
+// next.  A conversion can panic, which would longjmp out of COPY-ODBC with
+// the worker still running on the HSTMT.  So the prefetch state is global,
+// and any native that might touch a statement calls Finish_Prefetch() first
+// to wait for the thread and free the blocks.
+//
+struct PrefetchStruct {
+    bool active;  // blocks allocated (and maybe a thread running)
+    bool thread_running;
+    Thread thread;
 
-    list->num_columns = num_columns;
-    list->next = g_all_columnlists;
-    g_all_columnlists = list;
+    SQLHSTMT hstmt;
+    const Column* columns;
+    RowBlock* target;  // block the thread is filling
+    SQLLEN max_rows;
 
-    Value* columns_value = rebHandle(list, 1, &Column_List_Handle_Cleaner);
+    RowBlock blocks[2];
+};
+typedef struct PrefetchStruct Prefetch;
 
-    rebElide("statement.columns:", rebR(columns_value));
+Prefetch g_prefetch;
 
-    Describe_ODBC_Results(hstmt, num_columns, list->columns);
+DECLARE_THREAD_FUNCTION(Prefetch_Thread_Function)
+{
+    Prefetch* pf = cast(Prefetch*, arg);
+    Fetch_Rows_Raw(pf->hstmt, pf->columns, pf->target, pf->max_rows);
+    return THREAD_FUNCTION_RESULT;
+}
 
-    Value* titles = rebValue("make block!", rebI(num_columns));
-    SQLSMALLINT column_index;
-    for (column_index = 1; column_index <= num_columns; ++column_index)
-        rebElide("append", titles, list->columns[column_index - 1].title);
+static void Finish_Prefetch(void) {
+    if (not g_prefetch.active)
+        return;
 
-    // remember column titles if next call matches, return them as the result
-    //
-    rebElide("statement.titles:", titles);
-    return titles;
+    if (g_prefetch.thread_running) {
+        Join_Thread(g_prefetch.thread);
+        g_prefetch.thread_running = false;
+    }
+
+    Free_Row_Block(&g_prefetch.blocks[0]);
+    Free_Row_Block(&g_prefetch.blocks[1]);
+    g_prefetch.active = false;
 }
 
+static void Panic_On_Row_Block_Failure(SQLHSTMT hstmt, RowBlock* block) {
+    if (block->rc == SQL_SUCCESS or block->rc == SQL_NO_DATA)
+        return;
 
+    Value* error;
+    if (block->failure)
+        error = rebValue("make error!", rebT(block->failure));
+    else
+        error = Error_ODBC_Stmt(hstmt);  // worker is joined, diag intact
+
+    Finish_Prefetch();
+    rebJumps ("panic", rebR(error));
+}
+
+
+// Named parameters like `:id` are changed in place to `?` (the SQL can only
+// get shorter), and their names are returned in order as a BLOCK! of WORD!s.
+// Quoted text and PostgreSQL-style `::type` casts are left alone.
 //
-// A query will fill a column's buffer with data.  This data can be
-// reinterpreted as a Rebol value.  Successive queries for records reuse the
-// buffer for a column.
-//
-// 1. We return a quasiform in the case of nulls so that it can be put in
-//    lists without an error.  This does mean that if people want an actual
-//    null value they will have to DEGRADE it, or otherwise check for the
-//    quasiform.
+static bool Is_Parameter_Name_Char(SQLWCHAR c, bool first) {
+    if (c == '_' or (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z'))
+        return true;
+    return not first and c >= '0' and c <= '9';
+}
+
+static Value* Rewrite_Named_Parameters(SQLWCHAR* sql) {
+    Value* names = rebValue("copy []");
+
+    SQLWCHAR* src = sql;
+    SQLWCHAR* dest = sql;
+    SQLWCHAR quote = 0;
+    while (*src != 0) {
+        SQLWCHAR c = *src;
+        if (quote != 0) {
+            if (c == quote)
+                quote = 0;
+        }
+        else if (c == '\'' or c == '"')
+            quote = c;
+        else if (c == ':' and src[1] == ':')
+            *dest++ = *src++;  // cast, copy both colons
+        else if (c == ':' and Is_Parameter_Name_Char(src[1], true)) {
+            SQLWCHAR* name = ++src;
+            while (Is_Parameter_Name_Char(*src, false))
+                ++src;
+            rebElide(
+                "append", names, "to word!",
+                    rebR(rebLengthedTextWide(name, src - name))
+            );
+            *dest++ = '?';
+            continue;
+        }
+        *dest++ = *src++;
+    }
+    *dest = 0;
+
+    return names;
+}
+
+
+// Used for SQL_ATTR_MAX_ROWS and SQL_ATTR_MAX_LENGTH, where 0 means no limit.
 //
-Value* ODBC_Column_To_Rebol_Value(
-    Column* col,
-    Option(SQLPOINTER) allocated,
-    SQLLEN len
+static SQLRETURN Set_Statement_Limit(
+    SQLHSTMT hstmt,
+    SQLINTEGER attribute,
+    SQLLEN limit
 ){
-    if (len == SQL_NULL_DATA)
-        return rebValue("'~null~");  // expects value can be put in block [1]
+    if (limit < 0)
+        rebJumps ("panic -[INSERT-ODBC limits can't be negative]-");
 
-    switch (col->c_type) {
-      case SQL_C_BIT:
-        //
-        // Note: MySQL ODBC returns -2 for sql_type when a field is BIT(n)
-        // where n != 1, as opposed to SQL_BIT and column_size of n.  See
-        // remarks on the panic() below.
-        //
-        if (len != 1)
-            rebJumps("panic -[BIT(n) fields are only supported for n = 1]-");
+    return SQLSetStmtAttr(
+        hstmt,
+        attribute,
+        p_cast(SQLPOINTER, cast(uintptr_t, limit)),
+        0
+    );
+}
 
-        if (*cast(unsigned char*, col->buffer))
-            return rebValue("'true");  // can't append antiform to block :-(
-        return rebValue("'false");
 
-       case SQL_C_UTINYINT:  // unsigned: 0..255
-        return rebInteger(*cast(unsigned char*, col->buffer));
+// Put an HSTMT back in the state SQLAllocHandle() gave it, and keep it for
+// Take_Statement_Handle() to hand out again.  Returns false if it should be
+// freed.
+//
+// 1. Only the attributes INSERT-ODBC sets are restored (IMPORT-ODBC and
+//    EXPORT-ARROW-ODBC put back the ones they use before they return).
+//
+static bool Pool_Statement_Handle(
+    Connection* conn,
+    SQLHSTMT hstmt,
+    bool reset_attributes  // see [1]
+){
+    if (
+        conn->hdbc == SQL_NULL_HANDLE
+        or conn->num_idle_hstmts >= conn->max_idle_hstmts
+    ){
+        return false;
+    }
 
-    // ODBC was asked at SQLGetData time to give back *most* integer
-    // types as SQL_C_SLONG or SQL_C_ULONG, regardless of actual size
-    // in the sql_type (not the c_type)
+    if (
+        not SQL_SUCCEEDED(SQLFreeStmt(hstmt, SQL_CLOSE))  // pending results
+        or not SQL_SUCCEEDED(SQLFreeStmt(hstmt, SQL_UNBIND))
+        or not SQL_SUCCEEDED(SQLFreeStmt(hstmt, SQL_RESET_PARAMS))
+    ){
+        return false;
+    }
 
-      case SQL_C_SLONG:  // signed: -32,768..32,767
-        return rebInteger(*cast(SQLINTEGER*, col->buffer));
+    if (reset_attributes) {
+        SQLRETURN rc = SQLSetStmtAttr(
+            hstmt,
+            SQL_ATTR_CURSOR_TYPE,
+            p_cast(SQLPOINTER, cast(uintptr_t, SQL_CURSOR_FORWARD_ONLY)),
+            0
+        );
+        if (
+            not SQL_SUCCEEDED(rc)
+            or not SQL_SUCCEEDED(
+                Set_Statement_Limit(hstmt, SQL_ATTR_MAX_ROWS, 0)
+            )
+            or not SQL_SUCCEEDED(
+                Set_Statement_Limit(hstmt, SQL_ATTR_MAX_LENGTH, 0)
+            )
+        ){
+            return false;
+        }
+    }
 
-      case SQL_C_ULONG:  // signed: -2[31]..2[31] - 1
-        return rebInteger64(*cast(SQLUINTEGER*, col->buffer));  // headroom
+    conn->idle_hstmts[conn->num_idle_hstmts] = hstmt;
+    ++conn->num_idle_hstmts;
+    return true;
+}
 
-    // Special exception made for big integers, where seemingly MySQL
-    // would not properly map smaller types into big integers if all
-    // you ask for are big ones.
-    //
-    // !!! Review: bug may not exist if SQLGetData() is used.
 
-      case SQL_C_SBIGINT:  // signed: -2[63]..2[63]-1
-        return rebInteger64(*cast(SQLBIGINT*, col->buffer));
+// BEGIN-ODBC:BATCH counts statements between commits.  Shared by INSERT-ODBC
+// and IMPORT-ODBC (where each executed batch of rows counts as one).
+//
+static bool Commit_If_Batch_Full(Connection* conn) {
+    if (conn->batch_size == 0 or ++conn->batch_count < conn->batch_size)
+        return true;
 
-      case SQL_C_UBIGINT:  // unsigned: 0..2[64] - 1
-        if (*cast(SQLUBIGINT*, col->buffer) > INT64_MAX)
-            rebJumps ("panic -[INTEGER! can't hold all unsigned 64-bit ints]-");
+    conn->batch_count = 0;
+    SQLRETURN rc = SQLEndTran(SQL_HANDLE_DBC, conn->hdbc, SQL_COMMIT);
+    return SQL_SUCCEEDED(rc);
+}
 
-        return rebInteger64(*cast(SQLUBIGINT*, col->buffer));
 
-    // ODBC was asked at column binding time to give back all floating
-    // point types as SQL_C_DOUBLE, regardless of actual size.
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// QUERY STATISTICS
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// When ODBC-SET-QUERY-STATS turns this on, INSERT-ODBC and COPY-ODBC record
+// how long the prepare, execute and fetch of each query take, and how many
+// rows it gave.  The numbers are kept per "shape" of query: the SQL with its
+// literals replaced by ?, so `WHERE id = 10` and `WHERE id = 20` (or `= ?`
+// with different parameters) are counted together.  ODBC-QUERY-STATS reports
+// percentiles from these, to find which queries are the slow ones.
+//
+// 1. Histograms are log-linear, like HdrHistogram: values below 8 have their
+//    own buckets, then each power of two is split into 8.  So any value is
+//    reported within 12.5%, with only 272 buckets for microseconds up to
+//    about 19 hours (or row counts up to 68 billion).
+//
+// 2. The table of shapes is fixed size, so a program making endless new SQL
+//    (e.g. with literals spliced in that aren't recognized) doesn't grow it
+//    without bound.  Shapes after the first MAX_QUERY_SHAPES are all counted
+//    together in one entry, reported with its SQL as "(other)".
+//
+// 3. A statement remembers its fingerprint, so re-running a prepared query
+//    doesn't have to normalize the SQL again.  If the fingerprint isn't in
+//    the table (stats were reset) it is just looked up again from the SQL.
+//
 
-      case SQL_C_DOUBLE:
-        return rebDecimal(*cast(SQLDOUBLE*, col->buffer));
+#define HIST_SUB_BITS 3  // see [1]
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_MAX_BITS 36
+#define HIST_BUCKETS (HIST_SUB_COUNT * (HIST_MAX_BITS - HIST_SUB_BITS + 1))
 
-      case SQL_C_TYPE_DATE: {
-        DATE_STRUCT* date = cast(DATE_STRUCT*, col->buffer);
-        return rebValue(
-            "make date! [",
-                rebI(date->year), rebI(date->month), rebI(date->day),
-            "]"
-        ); }
+struct HistogramStruct {
+    uint32_t counts[HIST_BUCKETS];
+    uint64_t count;
+    uint64_t total;
+    uint64_t max;
+};
+typedef struct HistogramStruct Histogram;
 
-      case SQL_C_TYPE_TIME: {
-        //
-        // The TIME_STRUCT in ODBC does not contain a fraction/nanosecond
-        // component.  Hence a TIME(7) might be able to store 17:32:19.123457
-        // but when it is retrieved it will just be 17:32:19
-        //
-        TIME_STRUCT* time = cast(TIME_STRUCT*, col->buffer);
-        return rebValue(
-            "make time! [",
-                rebI(time->hour), rebI(time->minute), rebI(time->second),
-            "]"
-        ); }
+static void Histogram_Add(Histogram* h, uint64_t value) {
+    int bucket;
+    if (value < HIST_SUB_COUNT)
+        bucket = cast(int, value);
+    else {
+        int high_bit = HIST_SUB_BITS;
+        while (high_bit < 63 and (value >> (high_bit + 1)) != 0)
+            ++high_bit;
+        if (high_bit >= HIST_MAX_BITS)
+            bucket = HIST_BUCKETS - 1;
+        else
+            bucket = (high_bit - HIST_SUB_BITS + 1) * HIST_SUB_COUNT
+                + cast(int, (value >> (high_bit - HIST_SUB_BITS)))
+                    % HIST_SUB_COUNT;
+    }
 
-    // Note: It's not entirely clear how to work with timezones in ODBC, there
-    // is a datatype called SQL_SS_TIMESTAMPOFFSET_STRUCT which extends
-    // TIMESTAMP_STRUCT with timezone_hour and timezone_minute.  Someone can
-    // try and figure this out in the future if they are so inclined.
+    ++h->counts[bucket];
+    ++h->count;
+    h->total += value;
+    if (value > h->max)
+        h->max = value;
+}
 
-      case SQL_C_TYPE_TIMESTAMP: {
-        TIMESTAMP_STRUCT* stamp = cast(TIMESTAMP_STRUCT*, col->buffer);
+// The highest value that would go in the bucket that holds the percentile.
+//
+static uint64_t Histogram_Percentile(const Histogram* h, int percent) {
+    if (h->count == 0)
+        return 0;
+
+    uint64_t rank = (h->count * percent + 99) / 100;  // round up
+    uint64_t seen = 0;
+    int bucket;
+    for (bucket = 0; bucket != HIST_BUCKETS - 1; ++bucket) {
+        seen += h->counts[bucket];
+        if (seen >= rank)
+            break;
+    }
 
-        // !!! The fraction is generally 0, even if you wrote a nonzero value
-        // in the timestamp:
-        //
-        // https://github.com/metaeducation/rebol-odbc/issues/1
-        //
-        SQLUINTEGER fraction = stamp->fraction;
+    if (bucket == HIST_BUCKETS - 1)  // also holds everything bigger
+        return h->max;
 
-        // !!! This isn't a very elegant way of combining a date and time
-        // component, but the point is that however it is done...it should
-        // be done with Rebol code vs. some special C date API.  See
-        // GitHub issue #2313 regarding improving the Rebol side.
-        //
-        return rebValue("ensure date! (make-date-ymdsnz",
-            rebI(stamp->year),
-            rebI(stamp->month),
-            rebI(stamp->day),
-            rebI(
-                stamp->hour * 3600 + stamp->minute * 60 + stamp->second
-            ),  // seconds
-            rebI(fraction),  // billionths of a second (nanoseconds)
-            "()",  // timezone (none)  !!! better API way to make voids?
-        ")"); }
+    uint64_t high;
+    if (bucket < HIST_SUB_COUNT)
+        high = bucket;
+    else {
+        int high_bit = bucket / HIST_SUB_COUNT + HIST_SUB_BITS - 1;
+        uint64_t width = cast(uint64_t, 1) << (high_bit - HIST_SUB_BITS);
+        high = (cast(uint64_t, 1) << high_bit)
+            + (bucket % HIST_SUB_COUNT) * width + width - 1;
+    }
+    return high < h->max ? high : h->max;
+}
 
-    // SQL_BINARY, SQL_VARBINARY, and SQL_LONGVARBINARY were all requested
-    // as SQL_C_BINARY.
+#define MAX_QUERY_SHAPES 128  // see [2]
+#define QUERY_SHAPE_SLOTS 256  // hash table, power of 2 and more than shapes
+#define QUERY_TEXT_SIZE 120  // how much of the normalized SQL is kept
 
-      case SQL_C_BINARY:
-        if (allocated)
-            return rebRepossess(unwrap allocated, len);
-        return rebSizedBlob(col->buffer, len);
+#define NO_FINGERPRINT 0  // (hashes of real SQL are assumed not to be these)
+#define OTHER_FINGERPRINT 1
 
-    // There's no guarantee that CHAR fields contain valid UTF-8, but we
-    // currently only support that.
-    //
-    // !!! Should there be a Latin1 fallback if the UTF-8 interpretation
-    // fails?
+struct QueryShapeStruct {
+    uint64_t fingerprint;  // hash of the whole normalized SQL
+    char text[QUERY_TEXT_SIZE];  // start of the normalized SQL
+    Histogram prepare;  // microseconds
+    Histogram execute;
+    Histogram fetch;  // per COPY-ODBC
+    Histogram rows;  // affected by DML, or given by each COPY-ODBC
+};
+typedef struct QueryShapeStruct QueryShape;
 
-      case SQL_C_CHAR: {
-        switch (g_char_column_encoding) {
-          case CHAR_COL_UTF8:
-            return rebSizedText(
-                cast(char*, col->buffer),  // unixodbc SQLCHAR is unsigned
-                len
-            );
+struct QueryStatsStruct {
+    QueryShape* shapes;  // MAX_QUERY_SHAPES + 1 (for "other"), or nullptr
+    int num_shapes;
+    int slots[QUERY_SHAPE_SLOTS];  // shape index + 1, or 0 if unused
+};
+typedef struct QueryStatsStruct QueryStats;
 
-          case CHAR_COL_UTF16:
-            assert(!"UTF-16/UCS-2 should have requested SQL_C_WCHAR");
-            break;
+QueryStats g_query_stats = { nullptr, 0, { 0 } };
 
-          case CHAR_COL_LATIN1: {
-            // Need to do a UTF-8 conversion for Rebol to use the string.
+static bool Is_SQL_Name_Byte(unsigned char c) {
+    return (c >= 'A' and c <= 'Z') or (c >= 'a' and c <= 'z')
+        or (c >= '0' and c <= '9') or c == '_' or c == '$' or c == '#'
+        or c >= 0x80;  // part of a UTF-8 encoded codepoint
+}
+
+// Literal strings, numbers and :name parameters become ?, comments go, and
+// whitespace is collapsed to single spaces.  Keywords and names outside of
+// quotes are uppercased.  A list of ?s (like from $[in list]) becomes one ?.
+// The result is never longer than the SQL, so `out` can be the same size.
+//
+static size_t Normalize_SQL(const char* sql, char* out) {
+    const unsigned char* cp = cast(const unsigned char*, sql);
+    size_t size = 0;
+    bool space = false;  // pending space, only written before another token
+
+    while (*cp != '\0') {
+        unsigned char c = *cp;
+
+        if (c == ' ' or c == '\t' or c == '\r' or c == '\n') {
+            space = (size != 0);
+            ++cp;
+            continue;
+        }
+        if (c == '-' and cp[1] == '-') {  // comment to end of line
+            while (*cp != '\0' and *cp != '\n')
+                ++cp;
+            space = (size != 0);
+            continue;
+        }
+        if (c == '/' and cp[1] == '*') {
+            cp += 2;
+            while (*cp != '\0' and not (cp[0] == '*' and cp[1] == '/'))
+                ++cp;
+            if (*cp != '\0')
+                cp += 2;
+            space = (size != 0);
+            continue;
+        }
+
+        if (space) {
+            out[size++] = ' ';
+            space = false;
+        }
+
+        bool name_before = size != 0 and Is_SQL_Name_Byte(out[size - 1]);
+        bool literal = false;
+
+        if (c == '\'') {  // string literal, '' is an escaped quote
+            ++cp;
+            while (*cp != '\0') {
+                if (*cp == '\'' and cp[1] == '\'')
+                    cp += 2;
+                else if (*cp++ == '\'')
+                    break;
+            }
+            literal = true;
+        }
+        else if (c >= '0' and c <= '9' and not name_before) {
+            while (Is_SQL_Name_Byte(*cp) or *cp == '.'
+                or ((*cp == '+' or *cp == '-')
+                    and (cp[-1] == 'e' or cp[-1] == 'E'))
+            ){
+                ++cp;  // digits, decimals, exponents, 0x hex...
+            }
+            literal = true;
+        }
+        else if (
+            c == ':' and Is_SQL_Name_Byte(cp[1]) and cp[1] < 0x80
+            and not (size != 0 and out[size - 1] == ':')  // e.g. x::INT
+            and not (cp != cast(const unsigned char*, sql) and cp[-1] == ':')
+        ){
+            ++cp;
+            while (Is_SQL_Name_Byte(*cp))
+                ++cp;
+            literal = true;
+        }
+        else if (c == '?') {
+            ++cp;
+            literal = true;
+        }
+        else if (c == '"' or c == '`') {  // quoted name, kept as is
+            out[size++] = *cp++;
+            while (*cp != '\0' and *cp != c)
+                out[size++] = *cp++;
+            if (*cp != '\0')
+                out[size++] = *cp++;
+            continue;
+        }
+        else {
+            out[size++] = (c >= 'a' and c <= 'z') ? c - 'a' + 'A' : c;
+            ++cp;
+            continue;
+        }
+
+        assert(literal);
+        UNUSED(literal);
+
+        size_t back = size;  // collapse `?, ?` to `?`
+        while (back != 0 and out[back - 1] == ' ')
+            --back;
+        if (back != 0 and out[back - 1] == ',') {
+            --back;
+            while (back != 0 and out[back - 1] == ' ')
+                --back;
+            if (back != 0 and out[back - 1] == '?') {
+                size = back;
+                continue;
+            }
+        }
+        out[size++] = '?';
+    }
+
+    out[size] = '\0';
+    return size;
+}
+
+// FNV-1a
+//
+static uint64_t Hash_Bytes(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    size_t i;
+    for (i = 0; i != size; ++i) {
+        hash ^= cast(unsigned char, data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static Option(QueryShape*) Find_Query_Shape(uint64_t fingerprint) {
+    if (fingerprint == NO_FINGERPRINT)
+        return nullptr;
+
+    if (fingerprint == OTHER_FINGERPRINT) {  // see [2]
+        if (g_query_stats.num_shapes != MAX_QUERY_SHAPES)
+            return nullptr;  // was reset
+        return &g_query_stats.shapes[MAX_QUERY_SHAPES];
+    }
+
+    size_t slot = fingerprint & (QUERY_SHAPE_SLOTS - 1);
+    while (g_query_stats.slots[slot] != 0) {
+        QueryShape* shape = &g_query_stats.shapes[
+            g_query_stats.slots[slot] - 1
+        ];
+        if (shape->fingerprint == fingerprint)
+            return shape;
+        slot = (slot + 1) & (QUERY_SHAPE_SLOTS - 1);
+    }
+    return nullptr;
+}
+
+static QueryShape* Query_Shape_Of_SQL(const char* sql) {
+    char* normalized = rebAllocN(char, strlen(sql) + 1);
+    size_t size = Normalize_SQL(sql, normalized);
+    uint64_t fingerprint = Hash_Bytes(normalized, size);
+
+    QueryShape* shape = opt Find_Query_Shape(fingerprint);
+    if (shape == nullptr) {
+        if (g_query_stats.num_shapes == MAX_QUERY_SHAPES) {  // see [2]
+            shape = &g_query_stats.shapes[MAX_QUERY_SHAPES];
+            if (shape->text[0] == '\0') {
+                shape->fingerprint = OTHER_FINGERPRINT;
+                strcpy(shape->text, "(other)");
+            }
+        }
+        else {
+            shape = &g_query_stats.shapes[g_query_stats.num_shapes];
+            ++g_query_stats.num_shapes;
+
+            size_t slot = fingerprint & (QUERY_SHAPE_SLOTS - 1);
+            while (g_query_stats.slots[slot] != 0)
+                slot = (slot + 1) & (QUERY_SHAPE_SLOTS - 1);
+            g_query_stats.slots[slot] = g_query_stats.num_shapes;
+
+            shape->fingerprint = fingerprint;
+            if (size >= QUERY_TEXT_SIZE) {  // cut before a UTF-8 lead byte
+                size = QUERY_TEXT_SIZE - 1;
+                while (size != 0 and (normalized[size] & 0xC0) == 0x80)
+                    --size;
+            }
+            memcpy(shape->text, normalized, size);
+            shape->text[size] = '\0';
+        }
+    }
+
+    rebFree(normalized);
+    return shape;
+}
+
+static void Add_Fetch_Stats(
+    QueryShape* shape,
+    uint64_t started,  // from Now_Microseconds()
+    const Value* rows
+){
+    Histogram_Add(&shape->fetch, Now_Microseconds() - started);
+    Histogram_Add(&shape->rows, rebUnbox("length of", rows));
+}
+
+static void Reset_Query_Stats(void) {
+    if (g_query_stats.shapes)
+        memset(
+            g_query_stats.shapes, 0,
+            sizeof(QueryShape) * (MAX_QUERY_SHAPES + 1)
+        );
+    g_query_stats.num_shapes = 0;
+    memset(g_query_stats.slots, 0, sizeof(g_query_stats.slots));
+}
+
+
+//
+//  export /insert-odbc: native [
+//
+//  "Executes SQL statements (prepare on first pass, executes conservatively)"
+//
+//      return: [
+//          integer!    "Row count for row change"
+//          block!      "Column title BLOCK! for selects"
+//      ]
+//      statement [object!]
+//      sql "Dialect beginning with TABLES, COLUMNS, TYPES, or SQL STRING!"
+//          [block!]
+//      :cursor "Cursor type for scrolling with COPY-ODBC (default FORWARD)"
+//          [~[forward static keyset dynamic]~]
+//      :max-rows "Have the server send at most this many rows (0 for all)"
+//          [integer!]
+//      :max-length "Truncate text and binary column data to this many bytes"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(INSERT_ODBC)
+//
+// 1. Only forward-only cursors are cheap, so that's the default.  Scrollable
+//    cursors let COPY-ODBC:ABSOLUTE etc. jump around in the result without
+//    running the query again.  The cursor type can't be changed once the
+//    statement is prepared, so a change means preparing again.  (Drivers may
+//    substitute a type they support, with SQL_SUCCESS_WITH_INFO.)
+//
+// 2. COPY-ODBC:PART stops fetching after N rows, but by then the server has
+//    planned and begun sending the whole result.  SQL_ATTR_MAX_ROWS tells it
+//    the limit before SQLExecute(), so it can use a top-N plan.  Likewise
+//    SQL_ATTR_MAX_LENGTH keeps "preview" queries from sending whole LOBs.
+//    These attributes stay set on the HSTMT, so the statement object keeps
+//    track of them to avoid setting them again on every execution.
+//
+// 3. Instead of values for each ? in the SQL, an OBJECT! or MAP! can give
+//    values for `:name` markers.  These are turned into ?s when preparing,
+//    and the names are kept in order as statement.param-names.  So later
+//    runs of the same SQL just select the fields, positions already known.
+//    A NULL map value (or object field) is passed as SQL NULL.
+//
+// 4. With ODBC-SET-QUERY-STATS on, the prepare and execute times are added
+//    to the histograms for the shape of the SQL.  (See QUERY STATISTICS.)
+//    The statement's fingerprint is for COPY-ODBC to find the same shape, so
+//    it's cleared when a new SQL string is prepared with the stats off.
+//
+// 5. Every DML statement goes through here (ODBC-EXECUTE and INSERT on a
+//    statement port included), so this is where ODBC-EXECUTE:CACHE results
+//    of the table it changes are dropped.  That returns right away when the
+//    cache is empty.
+{
+    INCLUDE_PARAMS_OF_INSERT_ODBC;
+
+    Finish_Prefetch();  // no worker thread may be using a handle
+
+    SQLHSTMT hstmt = rebUnboxHandle(
+        SQLHSTMT*, "ensure handle! statement.hstmt"
+    );
+
+    SQLRETURN rc;
+    rc = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);  // !!! check rc?
+    rc = SQLCloseCursor(hstmt);  // !!! check rc?
+    UNUSED(rc);
+
+    if (rebUnboxLogic(  // see [1]
+        "(any [cursor, 'forward]) <> statement.cursor"
+    )){
+        SQLULEN cursor_type = rebUnboxInteger(
+            "switch any [cursor, 'forward] [",
+                "'forward [", rebI(SQL_CURSOR_FORWARD_ONLY), "]",
+                "'static [", rebI(SQL_CURSOR_STATIC), "]",
+                "'keyset [", rebI(SQL_CURSOR_KEYSET_DRIVEN), "]",
+                "'dynamic [", rebI(SQL_CURSOR_DYNAMIC), "]",
+            "]"
+        );
+        rc = SQLSetStmtAttr(
+            hstmt,
+            SQL_ATTR_CURSOR_TYPE,
+            p_cast(SQLPOINTER, cast(uintptr_t, cursor_type)),
+            0
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+        rebElide(
+            "statement.cursor: any [cursor, 'forward]",
+            "statement.string: null"  // must prepare again
+        );
+    }
+
+    if (rebUnboxLogic(  // see [2]
+        "(any [max-rows, 0]) <> statement.max-rows"
+    )){
+        rc = Set_Statement_Limit(
+            hstmt, SQL_ATTR_MAX_ROWS, rebUnboxInteger("any [max-rows, 0]")
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+        rebElide("statement.max-rows: any [max-rows, 0]");
+    }
+
+    if (rebUnboxLogic(
+        "(any [max-length, 0]) <> statement.max-length"
+    )){
+        rc = Set_Statement_Limit(
+            hstmt, SQL_ATTR_MAX_LENGTH, rebUnboxInteger("any [max-length, 0]")
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+        rebElide("statement.max-length: any [max-length, 0]");
+    }
+
+    //=//// MAKE SQL REQUEST FROM DIALECTED SQL BLOCK /////////////////////=//
+    //
+    // The block passed in is used to form a query.
+
+    bool use_cache = false;
+    QueryShape* shape = nullptr;  // see [4]
+
+    bool get_catalog = rebUnboxBoolean(
+        "switch:type first sql [",
+            "lit-word?/ ['true]",  // like Rebol2: 'tables, 'columns, 'types
+            "text! ['false]",
+        "] else [",
+            "panic [",
+                "-[SQL dialect must start with WORD! or TEXT! value:]- @sql"
+            "]",
+        "]"
+    );
+
+    if (get_catalog) {
+        Value* sql = rebValue("sql");
+        rc = Get_ODBC_Catalog(hstmt, sql);
+        rebRelease(sql);
+        rebElide("statement.fingerprint: null");
+    }
+    else {
+        // Prepare/Execute statement, when first element in the block is a
+        // (statement) string
+
+        rebElide("invalidate-result-cache first sql");  // see [5]
+
+        // Compare with previously prepared statement, and if not the same,
+        // then prepare a new statement.
+        //
+        use_cache = rebUnboxLogic(
+            "equal? (first sql) ensure [<null> text!] statement.string"
+        );
+
+        bool named = rebUnboxLogic(  // see [3]
+            "all [2 = length of sql, did match [object! map!] second sql]"
+        );
+        if (named != rebUnboxLogic("did statement.param-names"))
+            use_cache = false;
+
+        SQLLEN sql_index = 1;
+
+        if (g_query_stats.shapes) {
+            if (use_cache)
+                shape = opt Find_Query_Shape(rebUnboxInteger64(
+                    "any [statement.fingerprint, 0]"
+                ));
+            if (shape == nullptr) {
+                char* text = rebSpell("first sql");
+                shape = Query_Shape_Of_SQL(text);
+                rebFree(text);
+                rebElide(
+                    "statement.fingerprint:",
+                        rebInteger64(cast(int64_t, shape->fingerprint))
+                );
+            }
+        }
+
+        uint64_t started;
+
+        if (not use_cache) {
+            SQLWCHAR *sql_string = rebSpellWide("first sql");
+
+            if (named) {
+                Value* names = Rewrite_Named_Parameters(sql_string);
+                rebElide("statement.param-names:", rebR(names));
+            }
+            else
+                rebElide("statement.param-names: null");
+
+            started = Now_Microseconds();
+            rc = SQLPrepareW(
+                hstmt,
+                sql_string,
+                SQL_NTS  // Null-Terminated String
+            );
+            if (not SQL_SUCCEEDED(rc))
+                return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+            if (shape)
+                Histogram_Add(&shape->prepare, Now_Microseconds() - started);
+
+            rebFree(sql_string);
+
+            // Remember statement string handle, but keep a copy since it
+            // may be mutated by the user.
             //
-            // !!! This is a slow way to do it; but optimize when needed.
-            // (Should there be rebSizedTextLatin1() ?)
+            // !!! Could re-use value with existing series if read only
             //
-            Value* binary = rebSizedBlob(
-                cast(unsigned char*, col->buffer),
-                len
+            rebElide(
+                "statement.string: copy first sql",
+                shape ? "" : "statement.fingerprint: null"  // see [4]
             );
-            return rebValue(
-                "append make text!", rebI(len),
-                    "map-each 'byte", rebR(binary), "[make-char byte]"
-            ); }
         }
-        break; }
 
-      case SQL_C_WCHAR:
-        assert(len % 2 == 0);
-        return rebLengthedTextWide(
-            cast(SQLWCHAR*, col->buffer),
-            len / 2
-        );
+        // The SQL string may contain ? characters, which indicates that it is
+        // a parameterized query.  The separation of the parameters into a
+        // different quarantined part of the query is to protect against SQL
+        // injection.
 
-      default:
-        break;
+        SQLLEN num_params = named
+            ? rebUnbox("length of statement.param-names")
+            : rebUnbox("length of sql") - sql_index;
+
+        ++sql_index;
+
+        Parameter* params = nullptr;
+        if (num_params != 0) {
+            Connection* conn = rebUnboxHandle(Connection*,
+                "ensure handle! statement.database.hdbc"
+            );
+            CharColumnEncoding encoding = Char_Encoding_Of(&conn->caps);
+
+            Reset_Arena(&g_param_arena);
+            params = cast(Parameter*,
+                Arena_Alloc(&g_param_arena, sizeof(Parameter) * num_params)
+            );
+
+            SQLLEN n;
+            for (n = 0; n < num_params; ++n, ++sql_index) {
+                Value* value = named
+                    ? rebValue(
+                        "let name: pick statement.param-names", rebI(n + 1),
+                        "let fields: second sql",
+                        "if all [object? fields, not has fields name] [",
+                            "panic [-[No field for SQL parameter:]- name]",
+                        "]",
+                        "(select fields name) else ['~null~]"
+                    )
+                    : rebValue("pick sql", rebI(sql_index));
+                rc = ODBC_BindParameter(
+                    hstmt,
+                    &params[n],
+                    n + 1,
+                    value,
+                    encoding,
+                    &g_param_arena,
+                    true  // may_stream
+                );
+                rebRelease(value);
+                if (not SQL_SUCCEEDED(rc))
+                    return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+            }
+        }
+
+        // Execute statement, but don't check result code until after the
+        // parameters and their data buffers have been freed.
+        //
+        started = Now_Microseconds();
+        rc = SQLExecute(hstmt);
+        if (rc == SQL_NEED_DATA)  // big BLOB!s, see ODBC_BindParameter()
+            rc = Put_Streamed_Parameters(hstmt, params);
+
+        if (shape)
+            Histogram_Add(&shape->execute, Now_Microseconds() - started);
+
+        Free_Parameters(params, num_params);
+
+        switch (rc) {
+          case SQL_SUCCESS:
+          case SQL_SUCCESS_WITH_INFO:
+            break;
+
+          case SQL_NO_DATA:  // UPDATE, INSERT, or DELETE affecting no rows
+            break;
+
+          case SQL_NEED_DATA:
+            assert(!"SQL_NEED_DATA seen after Put_Streamed_Parameters()");
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+          case SQL_STILL_EXECUTING:
+            assert(!"SQL_STILL_EXECUTING seen...only w/async calls");
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+          case SQL_ERROR:
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+          case SQL_INVALID_HANDLE:
+            assert(!"SQL_INVALID_HANDLE seen...should never happen");
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+        #if ODBCVER >= 0x0380
+          case SQL_PARAM_DATA_AVAILABLE:
+            assert(!"SQL_PARAM_DATA_AVAILABLE seen...only in ODBC 3.8");
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+        #endif
+        }
+
+        // If BEGIN-ODBC:BATCH was used, commit every N statements so a bulk
+        // load doesn't build up one giant transaction on the server.
+        //
+        if (g_num_batching_connections != 0) {
+            Connection* conn = rebUnboxHandle(Connection*,
+                "ensure handle! statement.database.hdbc"
+            );
+            if (not Commit_If_Batch_Full(conn))
+                return rebDelegate("panic", Error_ODBC_Dbc(conn->hdbc));
+        }
+    }
+
+    //=//// RETURN RECORD COUNT IF NO RESULT ROWS /////////////////////////=//
+    //
+    // Insert or Update or Delete statements do not return records, and this
+    // is indicated by a 0 count for columns in the return result.
+
+    SQLSMALLINT num_columns;
+    rc = SQLNumResultCols(hstmt, &num_columns);
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+    if (num_columns == 0) {
+        SQLLEN num_rows;
+        rc = SQLRowCount(hstmt, &num_rows);
+        if (not SQL_SUCCEEDED(rc))
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+        if (shape and num_rows >= 0)  // -1 if driver doesn't know
+            Histogram_Add(&shape->rows, num_rows);
+
+        return rebInteger(num_rows);
+    }
+
+    //=//// RETURN CACHED TITLES BLOCK OR REBUILD IF NEEDED ///////////////=//
+    //
+    // A SELECT statement or a request for a catalog listing of tables or
+    // other database features will generate rows.  However, this routine only
+    // returns the titles of the columns.  COPY-ODBC is used to actually get
+    // the values.
+    //
+    // !!! The reason it is factored this way might have dealt with the idea
+    // that you could want to have different ways of sub-querying the results
+    // vs. having all the records spewed to you.  The results might also be
+    // very large so you don't want them all in memory at once.  The COPY-ODBC
+    // routine does this.
+
+    if (use_cache)
+        return rebValue("ensure block! statement.titles");
+
+    Value* old_columns_value = rebValue(
+        "ensure [<null> handle!] statement.columns"
+    );
+    if (old_columns_value) {
+        //
+        // Because we have the HANDLE! here we could go ahead and free the
+        // columnlist itself (not just the columns), but that would mean the
+        // GC of the HANDLE! would need to detect nulls.  Just let the GC do
+        // the free.
+        //
+        ColumnList* old_list = rebUnboxHandle(ColumnList*, old_columns_value);
+        Force_ColumnList_Cleanup(old_list);
+        rebRelease(old_columns_value);
+    }
+
+    ColumnList* list = cast(ColumnList*, Slab_Alloc(&g_columnlist_slab));
+    if (list == nullptr)
+        return "panic -[Could not allocate ODBC column list]-";
+
+    list->columns = rebAllocN(Column, num_columns);
+    rebUnmanageMemory(list->columns);
+
+    list->num_columns = num_columns;
+    Link_Column_List(list);
+
+    Value* columns_value = rebHandle(list, 1, &Column_List_Handle_Cleaner);
+
+    rebElide("statement.columns:", rebR(columns_value));
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! statement.database.hdbc"
+    );
+    Describe_ODBC_Results(hstmt, num_columns, list->columns, &conn->caps);
+
+    Value* titles = rebValue("make block!", rebI(num_columns));
+    SQLSMALLINT column_index;
+    for (column_index = 1; column_index <= num_columns; ++column_index)
+        rebElide("append", titles, list->columns[column_index - 1].title);
+
+    // remember column titles if next call matches, return them as the result
+    //
+    rebElide(
+        "statement.titles:", titles,
+        "statement.row-proto: null"  // COPY-ODBC:SHAPE must remake it
+    );
+    return titles;
+}
+
+
+//
+// A query will fill a column's buffer with data.  This data can be
+// reinterpreted as a Rebol value.  Successive queries for records reuse the
+// buffer for a column.  (The buffer is passed separately from the column, so
+// that data fetched ahead of time into other memory can be converted too.)
+//
+// 1. We return a quasiform in the case of nulls so that it can be put in
+//    lists without an error.  This does mean that if people want an actual
+//    null value they will have to DEGRADE it, or otherwise check for the
+//    quasiform.
+//
+Value* ODBC_Column_To_Rebol_Value(
+    Column* col,
+    SQLPOINTER buffer,  // col->buffer, or a prefetched copy of the cell
+    Option(SQLPOINTER) allocated,
+    SQLLEN len
+){
+    if (len == SQL_NULL_DATA)
+        return rebValue("'~null~");  // expects value can be put in block [1]
+
+    switch (col->c_type) {
+      case SQL_C_BIT:
+        //
+        // Note: MySQL ODBC returns -2 for sql_type when a field is BIT(n)
+        // where n != 1, as opposed to SQL_BIT and column_size of n.  See
+        // remarks on the panic() below.
+        //
+        if (len != 1)
+            rebJumps("panic -[BIT(n) fields are only supported for n = 1]-");
+
+        if (*cast(unsigned char*, buffer))
+            return rebValue("'true");  // can't append antiform to block :-(
+        return rebValue("'false");
+
+       case SQL_C_UTINYINT:  // unsigned: 0..255
+        return rebInteger(*cast(unsigned char*, buffer));
+
+    // ODBC was asked at SQLGetData time to give back *most* integer
+    // types as SQL_C_SLONG or SQL_C_ULONG, regardless of actual size
+    // in the sql_type (not the c_type)
+
+      case SQL_C_SLONG:  // signed: -32,768..32,767
+        return rebInteger(*cast(SQLINTEGER*, buffer));
+
+      case SQL_C_ULONG:  // signed: -2[31]..2[31] - 1
+        return rebInteger64(*cast(SQLUINTEGER*, buffer));  // headroom
+
+    // Special exception made for big integers, where seemingly MySQL
+    // would not properly map smaller types into big integers if all
+    // you ask for are big ones.
+    //
+    // !!! Review: bug may not exist if SQLGetData() is used.
+
+      case SQL_C_SBIGINT:  // signed: -2[63]..2[63]-1
+        return rebInteger64(*cast(SQLBIGINT*, buffer));
+
+      case SQL_C_UBIGINT:  // unsigned: 0..2[64] - 1
+        if (*cast(SQLUBIGINT*, buffer) > INT64_MAX)
+            rebJumps ("panic -[INTEGER! can't hold all unsigned 64-bit ints]-");
+
+        return rebInteger64(*cast(SQLUBIGINT*, buffer));
+
+    // ODBC was asked at column binding time to give back all floating
+    // point types as SQL_C_DOUBLE, regardless of actual size.
+
+      case SQL_C_DOUBLE:
+        return rebDecimal(*cast(SQLDOUBLE*, buffer));
+
+      case SQL_C_TYPE_DATE: {
+        DATE_STRUCT* date = cast(DATE_STRUCT*, buffer);
+        return rebValue(
+            "make date! [",
+                rebI(date->year), rebI(date->month), rebI(date->day),
+            "]"
+        ); }
+
+      case SQL_C_TYPE_TIME: {
+        //
+        // The TIME_STRUCT in ODBC does not contain a fraction/nanosecond
+        // component.  Hence a TIME(7) might be able to store 17:32:19.123457
+        // but when it is retrieved it will just be 17:32:19
+        //
+        TIME_STRUCT* time = cast(TIME_STRUCT*, buffer);
+        return rebValue(
+            "make time! [",
+                rebI(time->hour), rebI(time->minute), rebI(time->second),
+            "]"
+        ); }
+
+    // Note: It's not entirely clear how to work with timezones in ODBC, there
+    // is a datatype called SQL_SS_TIMESTAMPOFFSET_STRUCT which extends
+    // TIMESTAMP_STRUCT with timezone_hour and timezone_minute.  Someone can
+    // try and figure this out in the future if they are so inclined.
+
+      case SQL_C_TYPE_TIMESTAMP: {
+        TIMESTAMP_STRUCT* stamp = cast(TIMESTAMP_STRUCT*, buffer);
+
+        // !!! The fraction is generally 0, even if you wrote a nonzero value
+        // in the timestamp:
+        //
+        // https://github.com/metaeducation/rebol-odbc/issues/1
+        //
+        SQLUINTEGER fraction = stamp->fraction;
+
+        // !!! This isn't a very elegant way of combining a date and time
+        // component, but the point is that however it is done...it should
+        // be done with Rebol code vs. some special C date API.  See
+        // GitHub issue #2313 regarding improving the Rebol side.
+        //
+        return rebValue("ensure date! (make-date-ymdsnz",
+            rebI(stamp->year),
+            rebI(stamp->month),
+            rebI(stamp->day),
+            rebI(
+                stamp->hour * 3600 + stamp->minute * 60 + stamp->second
+            ),  // seconds
+            rebI(fraction),  // billionths of a second (nanoseconds)
+            "()",  // timezone (none)  !!! better API way to make voids?
+        ")"); }
+
+    // SQL_BINARY, SQL_VARBINARY, and SQL_LONGVARBINARY were all requested
+    // as SQL_C_BINARY.
+
+      case SQL_C_BINARY:
+        if (allocated)
+            return rebRepossess(unwrap allocated, len);
+        return rebSizedBlob(buffer, len);
+
+    // There's no guarantee that CHAR fields contain valid UTF-8, but we
+    // currently only support that.
+    //
+    // !!! Should there be a Latin1 fallback if the UTF-8 interpretation
+    // fails?
+
+      case SQL_C_CHAR: {
+        switch (col->encoding) {
+          case CHAR_COL_UTF8:
+            if (allocated)  // fetched by Get_Data_Direct(), don't copy it
+                return rebValue(
+                    "as text!", rebR(rebRepossess(unwrap allocated, len))
+                );
+            return rebSizedText(
+                cast(char*, buffer),  // unixodbc SQLCHAR is unsigned
+                len
+            );
+
+          case CHAR_COL_UTF16:
+            assert(!"UTF-16/UCS-2 should have requested SQL_C_WCHAR");
+            break;
+
+          case CHAR_COL_LATIN1: {
+            // Need to do a UTF-8 conversion for Rebol to use the string.
+            //
+            // !!! This is a slow way to do it; but optimize when needed.
+            // (Should there be rebSizedTextLatin1() ?)
+            //
+            Value* binary = rebSizedBlob(
+                cast(unsigned char*, buffer),
+                len
+            );
+            return rebValue(
+                "append make text!", rebI(len),
+                    "map-each 'byte", rebR(binary), "[make-char byte]"
+            ); }
+        }
+        break; }
+
+      case SQL_C_WCHAR:
+        assert(len % 2 == 0);
+        return rebLengthedTextWide(
+            cast(SQLWCHAR*, buffer),
+            len / 2
+        );
+
+      default:
+        break;
+    }
+
+    // Note: This happens with BIT(2) and the MySQL ODBC driver, which
+    // reports a sql_type of -2 for some reason.
+    //
+    rebJumps("panic -[Unsupported SQL_XXX type returned from query]-");
+}
+
+
+// COPY-ODBC rows are BLOCK!s by default.  With :SHAPE 'OBJECT, every row is
+// a COPY of one prototype object made from the titles, so all the rows share
+// its keylist and only the values are new.  :SHAPE 'MAP rows are MAP!s, with
+// the same WORD!s as keys.
+//
+// COPY-ODBC:COLUMNS fetches the columns in ascending order (drivers needn't
+// allow SQLGetData() to go backwards), so if the columns were asked for in
+// another order then `positions` says where each fetched value goes.
+//
+typedef enum {
+    ROW_SHAPE_BLOCK,
+    ROW_SHAPE_OBJECT,
+    ROW_SHAPE_MAP
+} RowShape;
+
+struct RowShaperStruct {
+    RowShape shape;
+    Value* proto;  // OBJECT! the rows are copied from (if ROW_SHAPE_OBJECT)
+    Value** words;  // key for each fetched column
+    SQLSMALLINT* positions;  // BLOCK! index of each fetched column, or null
+};
+typedef struct RowShaperStruct RowShaper;
+
+static Value* Make_Row(
+    Option(const RowShaper*) shaper,
+    SQLSMALLINT num_columns
+){
+    if (not shaper or (unwrap shaper)->shape == ROW_SHAPE_BLOCK) {
+        if (shaper and (unwrap shaper)->positions)  // filled in by POKE
+            return rebValue(
+                "append:dup make block!", rebI(num_columns),
+                    "'~null~", rebI(num_columns)
+            );
+        return rebValue("make block!", rebI(num_columns));
+    }
+
+    if ((unwrap shaper)->shape == ROW_SHAPE_OBJECT)
+        return rebValue("copy", (unwrap shaper)->proto);
+
+    return rebValue("make map!", rebI(num_columns));
+}
+
+static void Add_Row_Value(
+    Option(const RowShaper*) shaper,
+    Value* row,
+    SQLSMALLINT column_index,  // 0-based, in the order fetched
+    const Value* value
+){
+    if (not shaper or (unwrap shaper)->shape == ROW_SHAPE_BLOCK) {
+        if (shaper and (unwrap shaper)->positions) {
+            SQLSMALLINT position = (unwrap shaper)->positions[column_index];
+            rebElide("poke", row, rebI(position + 1), rebQ(value));
+        }
+        else
+            rebElide("append", row, rebQ(value));  // rebQ for ~null~ etc.
+        return;
+    }
+
+    Value* word = (unwrap shaper)->words[column_index];
+    if ((unwrap shaper)->shape == ROW_SHAPE_OBJECT)
+        rebElide("set has", row, rebQ(word), rebQ(value));
+    else
+        rebElide("put", row, rebQ(word), rebQ(value));
+}
+
+
+// Turn the rows in a RowBlock into Rebol rows appended to `results`.
+//
+static void Append_Row_Block_Values(
+    Value* results,
+    Column* columns,
+    RowBlock* block,
+    Option(const RowShaper*) shaper
+){
+    SQLLEN row;
+    for (row = 0; row != block->num_rows; ++row) {
+        Value* record = Make_Row(shaper, block->num_columns);
+
+        size_t cell = cast(size_t, row) * block->num_columns;
+
+        SQLSMALLINT n;
+        for (n = 0; n != block->num_columns; ++n, ++cell) {
+            SQLUSMALLINT number = Row_Block_Column_Number(block, n);
+            Value* temp = ODBC_Column_To_Rebol_Value(
+                &columns[number - 1],
+                block->bytes.data + block->offsets[cell],
+                nullptr,
+                block->lengths[cell]
+            );
+            Add_Row_Value(shaper, record, n, temp);
+            rebRelease(temp);
+        }
+
+        rebElide("append", results, rebR(record));
+    }
+}
+
+
+// 1. If a thread can't be started, just fetch synchronously (it's slower but
+//    gives the same result).
+//
+static void Copy_Rows_With_Prefetch(
+    SQLHSTMT hstmt,
+    Column* columns,
+    SQLSMALLINT num_columns,  // how many are fetched
+    const SQLUSMALLINT* column_numbers,  // nullptr for all
+    SQLLEN num_rows,  // -1 for as many as there are
+    SQLLEN block_rows,
+    Value* results,
+    Option(const RowShaper*) shaper
+){
+    Prefetch* pf = &g_prefetch;
+    assert(not pf->active);
+
+    Init_Row_Block(&pf->blocks[0], num_columns);
+    Init_Row_Block(&pf->blocks[1], num_columns);
+    pf->blocks[0].column_numbers = column_numbers;
+    pf->blocks[1].column_numbers = column_numbers;
+    pf->active = true;
+    pf->hstmt = hstmt;
+    pf->columns = columns;
+
+    SQLLEN remaining = num_rows;
+
+    int cur = 0;
+    Fetch_Rows_Raw(  // nothing to overlap with on the first block
+        hstmt,
+        columns,
+        &pf->blocks[cur],
+        (remaining == -1 or remaining > block_rows) ? block_rows : remaining
+    );
+
+    while (true) {
+        RowBlock* block = &pf->blocks[cur];
+        Panic_On_Row_Block_Failure(hstmt, block);
+
+        if (remaining != -1)
+            remaining -= block->num_rows;
+
+        bool more = (block->rc == SQL_SUCCESS and remaining != 0);
+        if (more) {
+            pf->target = &pf->blocks[1 - cur];
+            pf->max_rows = (remaining == -1 or remaining > block_rows)
+                ? block_rows
+                : remaining;
+
+            pf->thread_running = Start_Thread(
+                &pf->thread, &Prefetch_Thread_Function, pf
+            );
+            if (not pf->thread_running)  // see [1]
+                Fetch_Rows_Raw(hstmt, columns, pf->target, pf->max_rows);
+        }
+
+        Append_Row_Block_Values(results, columns, block, shaper);
+
+        if (not more)
+            break;
+
+        if (pf->thread_running) {
+            Join_Thread(pf->thread);
+            pf->thread_running = false;
+        }
+        cur = 1 - cur;
+    }
+
+    Finish_Prefetch();
+}
+
+
+
+// Variable-length UTF-8 text and binary columns are fetched by COPY-ODBC
+// straight into memory from rebAllocBytes(), which rebRepossess() can turn
+// into the TEXT! or BLOB! without copying.  (Going through col->buffer would
+// write every byte twice: once by the driver, and again by rebSizedText().)
+//
+// The first guess at the size is the longest value seen so far in the
+// column (up to DIRECT_GUESS_MAX), so after a few rows there's usually just
+// one SQLGetData() call.  If the data is truncated the buffer is grown and
+// the rest is fetched, which also means long columns aren't capped at the
+// col->buffer size.
+//
+// Returns nullptr with *len_out as SQL_NULL_DATA for NULL.  Otherwise the
+// caller owns the result, which has room for a terminator after *len_out.
+//
+// 1. rebRepossess() keeps the whole allocation as the TEXT! or BLOB!, so a
+//    short value in a big buffer is copied to a right-sized one.  Otherwise
+//    after one huge value in a column, every later cell would hold onto a
+//    buffer that big.
+//
+#define DIRECT_GUESS_MAX  (16 * 1024)
+
+static Option(char*) Get_Data_Direct(
+    SQLHSTMT hstmt,
+    SQLUSMALLINT column_index,
+    Column* col,
+    SQLLEN* len_out
+){
+    assert(col->c_type == SQL_C_CHAR or col->c_type == SQL_C_BINARY);
+
+    SQLULEN term = (col->c_type == SQL_C_CHAR) ? 1 : 0;  // driver adds '\0'
+
+    SQLULEN capacity = col->high_water + 1;  // rebRepossess() wants +1
+    if (capacity < 16)
+        capacity = 16;
+    else if (capacity > DIRECT_GUESS_MAX)
+        capacity = DIRECT_GUESS_MAX;
+
+    char* data = rebAllocN(char, capacity);
+    SQLULEN size = 0;
+
+    while (true) {
+        SQLULEN usable = capacity - size - 1;  // leave room for terminator
+
+        SQLLEN len;
+        SQLRETURN rc = SQLGetData(
+            hstmt,
+            column_index,
+            col->c_type,
+            data + size,
+            usable + term,  // BufferLength counts the terminator, if any
+            &len
+        );
+
+        if (not SQL_SUCCEEDED(rc)) {
+            rebFree(data);
+            rebJumps("panic", Error_ODBC_Stmt(hstmt));
+        }
+
+        if (len == SQL_NULL_DATA) {
+            rebFree(data);
+            *len_out = SQL_NULL_DATA;
+            return nullptr;
+        }
+
+        if (len != SQL_NO_TOTAL and cast(SQLULEN, len) <= usable) {
+            size += len;  // the rest of the data fit
+            break;
+        }
+
+        SQLULEN needed = (len == SQL_NO_TOTAL)
+            ? capacity * 2
+            : size + len + 1;
+        size += usable;  // truncated, so the driver filled the buffer
+
+        char* bigger = rebAllocN(char, needed);
+        memcpy(bigger, data, size);
+        rebFree(data);
+        data = bigger;
+        capacity = needed;
+    }
+
+    if (size > col->high_water)
+        col->high_water = size;
+
+    if (capacity > 256 and size < capacity / 4) {  // see [1]
+        char* smaller = rebAllocN(char, size + 1);
+        memcpy(smaller, data, size + 1);
+        rebFree(data);
+        data = smaller;
+    }
+
+    *len_out = size;
+    return data;
+}
+
+
+//
+//  export /copy-odbc: native [
+//
+//  "Block of row blocks for selects and catalog functions"
+//
+//      return: [block!]
+//      statement [object!]
+//      :part [integer!]
+//      :prefetch "Fetch blocks of this many rows on a background thread"
+//          [integer!]
+//      :absolute "Start at this row (negative counts from end), needs :CURSOR"
+//          [integer!]
+//      :relative "Start this many rows from the current one, needs :CURSOR"
+//          [integer!]
+//      :prior "Start at the row before the current one, needs :CURSOR"
+//      :shape "Make each row a BLOCK! (default), OBJECT!, or MAP!"
+//          [~[block object map]~]
+//      :columns "Only fetch these columns, by number or title"
+//          [block!]
+//  ]
+//
+DECLARE_NATIVE(COPY_ODBC)
+//
+// 1. The scrolling refinements only decide where the first row comes from.
+//    The rest of the rows (up to :PART) are the ones that follow it.  If the
+//    scroll lands outside the result, SQL_NO_DATA gives an empty block.
+//
+// 2. The prototype object for :SHAPE rows is made from the titles once, and
+//    kept in the statement until INSERT-ODBC gets new titles.  Titles that
+//    aren't valid WORD!s need an AS alias in the SQL.  (The API handles and
+//    memory for the shaper are freed with the native's frame.)
+//
+// 3. Columns left out by :COLUMNS never have SQLGetData() called on them, so
+//    the driver doesn't have to send their data (e.g. big BLOBs from a
+//    `SELECT *`).  The rows have the columns in the order they were asked
+//    for, but they are fetched in ascending order, as ODBC drivers are only
+//    required to support SQLGetData() in that order.  (Unless the driver
+//    reports SQL_GD_ANY_ORDER, then they're just fetched in the order given.)
+//
+// 4. With ODBC-SET-QUERY-STATS on, the time for the whole COPY-ODBC and the
+//    number of rows it gives are added to the stats of the query's shape.
+{
+    INCLUDE_PARAMS_OF_COPY_ODBC;
+
+    uint64_t started = Now_Microseconds();
+    QueryShape* shape = nullptr;  // see [4]
+    if (g_query_stats.shapes)
+        shape = opt Find_Query_Shape(rebUnboxInteger64(
+            "any [statement.fingerprint, 0]"
+        ));
+
+    Finish_Prefetch();  // in case a prior COPY-ODBC:PREFETCH panicked
+
+    SQLHSTMT hstmt = rebUnboxHandle(SQLHSTMT,
+        "ensure handle! statement.hstmt"
+    );
+
+    ColumnList* list = rebUnboxHandle(ColumnList*,
+        "ensure handle! statement.columns"
+    );
+    Column* columns = list->columns;
+
+    if (hstmt == SQL_NULL_HANDLE or not columns)
+        return "panic -[Invalid statement object!]-";
+
+    SQLRETURN rc;
+
+    SQLSMALLINT num_columns;
+    rc = SQLNumResultCols(hstmt, &num_columns);
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+    // compares-0 based row against num_rows, so -1 is chosen to never match
+    // and hence mean "as many rows as available"
+    //
+    SQLLEN num_rows = rebUnbox("any [part, -1]");
+
+    Value* results = rebValue(
+        "make block!", rebI(num_rows == -1 ? 10 : num_rows)
+    );
+
+    // With :PREFETCH, a worker thread runs SQLFetch() and SQLGetData() for
+    // the next block of rows while the rows of the current block are turned
+    // into Rebol values.  This helps most when the database is remote, so
+    // time is spent waiting on the network.
+    //
+    SQLLEN prefetch = rebUnbox("any [prefetch, 0]");
+    if (prefetch < 0)
+        return "panic -[COPY-ODBC:PREFETCH block size must be positive]-";
+
+    SQLSMALLINT num_fetched = num_columns;  // see [3]
+    SQLUSMALLINT* fetched = nullptr;  // column numbers, ascending
+    SQLSMALLINT* positions = nullptr;  // index in row, if not ascending
+    Value* numbers = nullptr;  // column numbers, in the order asked for
+
+    if (rebUnboxLogic("did columns")) {
+        numbers = rebValue(
+            "map-each 'c columns [",
+                "let n: either integer? c [c] [",
+                    "let pos: find statement.titles to text! c",
+                    "either pos [index of pos] [0]",
+                "]",
+                "if not all [n >= 1, n <=", rebI(num_columns), "] [",
+                    "panic [-[COPY-ODBC:COLUMNS has no column]- mold c]",
+                "]",
+                "n",
+            "]"
+        );
+        num_fetched = rebUnbox("length of", numbers);
+        if (num_fetched == 0)
+            return "panic -[COPY-ODBC:COLUMNS can't be empty]-";
+
+        SQLSMALLINT* slots = rebAllocN(SQLSMALLINT, num_columns);
+        SQLSMALLINT n;
+        for (n = 0; n != num_columns; ++n)
+            slots[n] = -1;
+
+        for (n = 0; n != num_fetched; ++n) {
+            SQLSMALLINT number = rebUnbox("pick", numbers, rebI(n + 1));
+            if (slots[number - 1] != -1)
+                return "panic -[COPY-ODBC:COLUMNS has a column twice]-";
+            slots[number - 1] = n;
+        }
+
+        fetched = rebAllocN(SQLUSMALLINT, num_fetched);
+        positions = rebAllocN(SQLSMALLINT, num_fetched);
+        bool ascending = true;
+
+        SQLSMALLINT k = 0;
+        for (n = 0; n != num_columns; ++n) {
+            if (slots[n] == -1)
+                continue;
+            fetched[k] = n + 1;
+            positions[k] = slots[n];
+            if (slots[n] != k)
+                ascending = false;
+            ++k;
+        }
+        rebFree(slots);
+
+        Connection* conn = rebUnboxHandle(Connection*,
+            "ensure handle! statement.database.hdbc"
+        );
+        if (not ascending and conn->caps.any_order) {  // see [3]
+            SQLUSMALLINT* ordered = rebAllocN(SQLUSMALLINT, num_fetched);
+            for (n = 0; n != num_fetched; ++n)
+                ordered[positions[n]] = fetched[n];
+            rebFree(fetched);
+            fetched = ordered;
+            ascending = true;
+        }
+
+        if (ascending) {
+            rebFree(positions);
+            positions = nullptr;
+        }
+    }
+
+    RowShaper row_shaper;
+    Option(const RowShaper*) shaper = nullptr;  // see [2]
+    row_shaper.shape = cast(RowShape, rebUnboxInteger(
+        "switch any [shape, 'block] [",
+            "'block [", rebI(ROW_SHAPE_BLOCK), "]",
+            "'object [", rebI(ROW_SHAPE_OBJECT), "]",
+            "'map [", rebI(ROW_SHAPE_MAP), "]",
+        "]"
+    ));
+    row_shaper.proto = nullptr;
+    row_shaper.words = nullptr;
+    row_shaper.positions = positions;
+
+    if (row_shaper.shape != ROW_SHAPE_BLOCK) {
+        if (numbers)  // only the columns asked for, so not cached
+            row_shaper.proto = rebValue(
+                "make object! collect [",
+                    "for-each 'n", numbers, "[",
+                        "keep setify to word! pick statement.titles n",
+                        "keep '~null~",
+                    "]",
+                "]"
+            );
+        else {
+            rebElide(
+                "if not statement.row-proto [",
+                    "statement.row-proto: make object! collect [",
+                        "for-each 'title statement.titles [",
+                            "keep setify to word! title",
+                            "keep '~null~",
+                        "]",
+                    "]",
+                "]"
+            );
+            row_shaper.proto = rebValue("statement.row-proto");
+        }
+
+        row_shaper.words = rebAllocN(Value*, num_fetched);
+        SQLSMALLINT n;
+        for (n = 0; n != num_fetched; ++n)
+            row_shaper.words[n] = rebValue(
+                "pick words of", row_shaper.proto,
+                    rebI((positions ? positions[n] : n) + 1)
+            );
+        shaper = &row_shaper;
+    }
+    else if (positions)
+        shaper = &row_shaper;
+
+    if (numbers)
+        rebRelease(numbers);
+
+    SQLSMALLINT orientation = SQL_FETCH_NEXT;  // see [1]
+    SQLLEN offset = 0;
+    if (rebUnboxLogic("did absolute")) {
+        orientation = SQL_FETCH_ABSOLUTE;
+        offset = rebUnboxInteger("absolute");
+    }
+    if (rebUnboxLogic("did relative")) {
+        if (orientation != SQL_FETCH_NEXT)
+            return "panic -[COPY-ODBC can only use one scrolling option]-";
+        orientation = SQL_FETCH_RELATIVE;
+        offset = rebUnboxInteger("relative");
+    }
+    if (rebUnboxLogic("prior")) {
+        if (orientation != SQL_FETCH_NEXT)
+            return "panic -[COPY-ODBC can only use one scrolling option]-";
+        orientation = SQL_FETCH_PRIOR;
+    }
+
+    if (orientation != SQL_FETCH_NEXT) {
+        Connection* conn = rebUnboxHandle(Connection*,
+            "ensure handle! statement.database.hdbc"
+        );
+        if (not conn->caps.fetch_scroll)
+            return "panic -[ODBC driver doesn't have SQLFetchScroll()]-";
+    }
+
+    if (prefetch != 0) {
+        if (orientation != SQL_FETCH_NEXT)
+            return "panic -[COPY-ODBC:PREFETCH can't be used with scrolling]-";
+
+        Copy_Rows_With_Prefetch(
+            hstmt,
+            columns,
+            num_fetched,
+            fetched,
+            num_rows,
+            prefetch,
+            results,
+            shaper
+        );
+        if (shape)
+            Add_Fetch_Stats(shape, started, results);
+        return results;
+    }
+
+    SQLLEN row = 0;
+    for (; row != num_rows; row = (num_rows == -1) ? 0 : row + 1) {
+
+        // This SQLFetch operation "fetches" the next row.  If we were using
+        // column binding, it would be writing data into the memory buffers
+        // we had given it.  But if you use column binding, your buffers have
+        // to be fixed size...and when they're not big enough, you lose the
+        // data.  By avoiding column binding, we can grow our buffers through
+        // multiple successive calls to SQLGetData().
+        //
+        if (orientation == SQL_FETCH_NEXT)
+            rc = SQLFetch(hstmt);
+        else {
+            rc = SQLFetchScroll(hstmt, orientation, offset);
+            orientation = SQL_FETCH_NEXT;
+        }
+
+        switch (rc) {
+          case SQL_SUCCESS:
+            break;  // Row retrieved, and data copied into column buffers
+
+          case SQL_SUCCESS_WITH_INFO: {
+            SQLWCHAR state[6];
+            SQLINTEGER native;
+
+            SQLSMALLINT message_len = 0;
+
+            // !!! It seems you wouldn't need the SQLWCHAR version for this,
+            // but Windows complains if you use SQLCHAR and try to call the
+            // non-W version.  :-/  Review.
+            //
+            rc = SQLGetDiagRecW(
+                SQL_HANDLE_STMT,  // HandleType
+                hstmt,  // Handle
+                1,  // RecNumber
+                state,  // SQLState
+                &native,  // NativeErrorPointer
+                nullptr,  // MessageText
+                0,  // BufferLength
+                &message_len  // TextLengthPtr
+            );
+
+            // Right now we ignore the "info" if there was success, but
+            // `state` is what you'd examine to know what the information is.
+            //
+            break; }
+
+          case SQL_NO_DATA:
+            goto no_more_data;
+
+          case SQL_INVALID_HANDLE:
+          case SQL_STILL_EXECUTING:
+          case SQL_ERROR:
+          default:  // No other return codes were listed
+            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+        }
+
+        Value* record = Make_Row(shaper, num_fetched);
+
+        SQLSMALLINT n;
+        for (n = 0; n != num_fetched; ++n) {
+            SQLUSMALLINT column_index = fetched ? fetched[n] : n + 1;
+            Column* col = &columns[column_index - 1];
+
+            SQLLEN len;
+            Option(SQLPOINTER) allocated;
+
+            if (
+                col->c_type == SQL_C_BINARY
+                or (col->c_type == SQL_C_CHAR
+                    and col->encoding == CHAR_COL_UTF8)
+            ){
+                allocated = Get_Data_Direct(hstmt, column_index, col, &len);
+                goto make_value;  // no copy out of col->buffer needed
+            }
+
+            if (col->buffer == nullptr)
+                assert(col->buffer_size == 0);
+
+            rc = SQLGetData(
+                hstmt,
+                column_index,
+                col->c_type,
+                col->buffer ? col->buffer : g_dummy_buffer,  // can't be null
+                col->buffer_size,  // zero if null
+                &len
+            );
+
+            if (col->buffer == nullptr and len == SQL_NO_TOTAL)
+                return "panic -[ODBC gave SQL_NO_TOTAL for var-size field]-";
+
+            switch (rc) {
+              case SQL_SUCCESS:
+                if (
+                    len != SQL_NULL_DATA
+                    and len > cast(SQLLEN, col->buffer_size)
+                ){
+                    assert(col->buffer == nullptr);  // Firebase does this (!)
+                    goto success_with_info;
+                }
+                allocated = nullptr;
+                break;
+
+              success_with_info:
+              case SQL_SUCCESS_WITH_INFO:  // potential truncation
+                assert(len != SQL_NULL_DATA);
+                assert(len != SQL_NO_TOTAL);
+                assert(col->buffer == nullptr);
+                allocated = rebAllocBytes(len + 1);  // can be rebRepossess()'d
+
+                if (len != 0) {  // MariaDB ODBC won't let you call with 0 len
+                    SQLLEN len_check;
+                    rc = SQLGetData(
+                        hstmt,
+                        column_index,
+                        col->c_type,
+                        unwrap allocated,
+                        len,  // amount of space in buffer
+                        &len_check
+                    );
+                    if (rc != SQL_SUCCESS)
+                        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+                    assert(len_check == len);
+                }
+                break;
+
+              case SQL_NO_DATA:
+                assert("!Got back SQL_NO_DATA from SQLGetData()");
+                goto no_more_data;
+
+              case SQL_ERROR:
+              case SQL_STILL_EXECUTING:
+              case SQL_INVALID_HANDLE:
+              default:  // No other return codes were listed
+                return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+            }
+
+          make_value: {
+            Value* temp = ODBC_Column_To_Rebol_Value(
+                col, col->buffer, allocated, len
+            );
+
+            Add_Row_Value(shaper, record, n, temp);
+            rebRelease(temp); }
+        }
+
+        rebElide("append", results, rebR(record));
+    }
+
+  no_more_data:
+
+    if (shape)
+        Add_Fetch_Stats(shape, started, results);
+    return results;
+}
+
+
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// PARALLEL QUERIES
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// PARALLEL-ODBC takes a block of independent jobs, each a block like
+// INSERT-ODBC's dialect but with a connection object first:
+//
+//     [connection "SELECT * FROM t WHERE x = ?" 10]
+//
+// Jobs are grouped by connection, and each connection gets a worker thread
+// that runs its jobs in order.  (One HDBC can't execute statements from two
+// threads at once, and many drivers only allow one active result set per
+// connection, so that is the unit of parallelism.)
+//
+// Anything needing the Rebol API happens on the interpreter thread: binding
+// parameters, and describing the result columns (which ODBC allows once a
+// statement is prepared).  The workers only do SQLExecute() and fetch rows
+// into RowBlocks.  After all workers are joined, the rows become Rebol values.
+//
+// Note the global `henv` and the g_all_connections list are only ever used on
+// the interpreter thread (by OPEN-CONNECTION and the HANDLE! cleaners), which
+// can't run while PARALLEL-ODBC is waiting on its workers.
+//
+
+struct ParallelJobStruct {
+    Connection* conn;
+    SQLHSTMT hstmt;
+
+    Parameter* params;
+    SQLLEN num_params;
+
+    Column* columns;  // nullptr if statement doesn't produce rows
+    SQLSMALLINT num_columns;
+
+    Value* error;  // set if the job failed on the interpreter thread
+    SQLRETURN rc;  // result of execution on the worker
+    SQLLEN row_count;  // for statements with no result columns
+    RowBlock rows;
+};
+typedef struct ParallelJobStruct ParallelJob;
+
+struct ParallelWorkerStruct {
+    Connection* conn;
+    ParallelJob* jobs;  // all of the jobs, worker runs those with its conn
+    SQLLEN num_jobs;
+    Thread thread;
+    bool thread_running;
+};
+typedef struct ParallelWorkerStruct ParallelWorker;
+
+static void Run_Parallel_Jobs(ParallelWorker* worker) {
+    SQLLEN i;
+    for (i = 0; i != worker->num_jobs; ++i) {
+        ParallelJob* job = &worker->jobs[i];
+        if (job->conn != worker->conn or job->error)
+            continue;
+
+        job->rc = SQLExecute(job->hstmt);
+        if (job->rc == SQL_NO_DATA)  // UPDATE, INSERT, DELETE affecting none
+            job->rc = SQL_SUCCESS;
+        if (not SQL_SUCCEEDED(job->rc))
+            continue;
+
+        if (job->num_columns == 0) {
+            job->rc = SQLRowCount(job->hstmt, &job->row_count);
+            continue;
+        }
+
+        Fetch_Rows_Raw(job->hstmt, job->columns, &job->rows, -1);
+        job->rc = job->rows.rc;
+    }
+}
+
+DECLARE_THREAD_FUNCTION(Parallel_Thread_Function)
+{
+    Run_Parallel_Jobs(cast(ParallelWorker*, arg));
+    return THREAD_FUNCTION_RESULT;
+}
+
+
+// Panic if a job spec is malformed, or has a parameter that can't be bound.
+// PARALLEL-ODBC checks every spec before it allocates anything, so that
+// preparing the jobs can't panic partway and leave HSTMTs and Columns behind.
+//
+static void Check_Parallel_Job_Spec(const Value* spec) {
+    rebElide(
+        "ensure handle! select ensure object! first", spec, "'hdbc",
+        "ensure text! second", spec
+    );
+
+    SQLLEN num_params = rebUnbox("length of", spec) - 2;
+    SQLLEN n;
+    for (n = 0; n != num_params; ++n) {
+        Value* value = rebValue("pick", spec, rebI(n + 3));
+        Parameter_C_Type(value);
+        rebRelease(value);
+    }
+}
+
+
+// Prepare, bind, and describe a job on the interpreter thread.  ODBC failures
+// are kept as the job's error rather than panicking, so they come back in
+// the job's slot of the result.  The spec was already checked.
+//
+static void Prepare_Parallel_Job(ParallelJob* job, const Value* spec) {
+    job->hstmt = SQL_NULL_HANDLE;
+    job->params = nullptr;
+    job->num_params = 0;
+    job->columns = nullptr;
+    job->num_columns = 0;
+    job->error = nullptr;
+    job->rc = SQL_SUCCESS;
+    job->row_count = 0;
+    Init_Row_Block(&job->rows, 0);
+
+    job->conn = rebUnboxHandle(Connection*, "select first", spec, "'hdbc");
+    if (job->conn->hdbc == SQL_NULL_HANDLE) {
+        job->error = rebValue("make error! -[Connection is closed]-");
+        return;
+    }
+
+    SQLRETURN rc = Take_Statement_Handle(job->conn, &job->hstmt);
+    if (not SQL_SUCCEEDED(rc)) {
+        job->hstmt = SQL_NULL_HANDLE;
+        job->error = Error_ODBC_Dbc(job->conn->hdbc);
+        return;
+    }
+
+    rebElide("invalidate-result-cache second", spec);  // as INSERT-ODBC does
+
+    SQLWCHAR *sql_string = rebSpellWide("second", spec);
+    rc = SQLPrepareW(job->hstmt, sql_string, SQL_NTS);
+    rebFree(sql_string);
+    if (not SQL_SUCCEEDED(rc)) {
+        job->error = Error_ODBC_Stmt(job->hstmt);
+        return;
+    }
+
+    job->num_params = rebUnbox("length of", spec) - 2;
+    if (job->num_params != 0) {
+        job->params = cast(Parameter*, Arena_Alloc(
+            &g_param_arena, sizeof(Parameter) * job->num_params
+        ));
+
+        SQLLEN n;
+        for (n = 0; n != job->num_params; ++n)
+            job->params[n].stream = nullptr;  // so Free_Parameters() is safe
+
+        for (n = 0; n != job->num_params; ++n) {
+            Value* value = rebValue("pick", spec, rebI(n + 3));
+            rc = ODBC_BindParameter(  // no streaming, workers can't use API
+                job->hstmt, &job->params[n], n + 1, value,
+                Char_Encoding_Of(&job->conn->caps), &g_param_arena, false
+            );
+            rebRelease(value);
+            if (not SQL_SUCCEEDED(rc)) {
+                job->error = Error_ODBC_Stmt(job->hstmt);
+                return;
+            }
+        }
+    }
+
+    rc = SQLNumResultCols(job->hstmt, &job->num_columns);
+    if (not SQL_SUCCEEDED(rc)) {
+        job->error = Error_ODBC_Stmt(job->hstmt);
+        return;
+    }
+
+    if (job->num_columns != 0) {
+        job->columns = rebAllocN(Column, job->num_columns);
+        Describe_ODBC_Results(
+            job->hstmt, job->num_columns, job->columns, &job->conn->caps
+        );
+        Init_Row_Block(&job->rows, job->num_columns);
+    }
+}
+
+static void Free_Parallel_Job(ParallelJob* job) {
+    Free_Parameters(job->params, job->num_params);
+    if (job->columns)
+        Free_Columns(job->columns, job->num_columns);
+    Free_Row_Block(&job->rows);
+    if (
+        job->hstmt != SQL_NULL_HANDLE
+        and not Pool_Statement_Handle(job->conn, job->hstmt, false)
+    ){
+        SQLFreeHandle(SQL_HANDLE_STMT, job->hstmt);
+        ++job->conn->num_hstmt_frees;
+    }
+}
+
+
+//
+//  export /parallel-odbc: native [
+//
+//  "Run independent queries with a worker thread per connection"
+//
+//      return: "BLOCK! of rows, INTEGER! row count, or ERROR! for each job"
+//          [block!]
+//      jobs "Blocks of [connection sql-text parameter ...]"
+//          [block!]
+//  ]
+//
+DECLARE_NATIVE(PARALLEL_ODBC)
+//
+// 1. The interpreter thread runs the jobs of the first connection itself
+//    instead of idling, so a single connection costs no threads at all.  If
+//    a thread can't be started, the same fallback is used.
+//
+// 2. Bad specs panic here, before any job has an HSTMT or Columns.  Once
+//    preparing starts, problems (e.g. a closed connection, or SQL that the
+//    driver rejects) become the job's ERROR! in the result instead.
+//
+// 3. If converting a result to Rebol values panics, the remaining jobs'
+//    memory leaks.  Their HSTMTs still get freed when the connection closes.
+{
+    INCLUDE_PARAMS_OF_PARALLEL_ODBC;
+
+    Finish_Prefetch();  // no worker thread may be using a handle
+
+    SQLLEN num_jobs = rebUnbox("length of jobs");
+    if (num_jobs == 0)
+        return rebValue("copy []");
+
+    SQLLEN i;
+    for (i = 0; i != num_jobs; ++i) {  // see [2]
+        Value* spec = rebValue("ensure block! pick jobs", rebI(i + 1));
+        Check_Parallel_Job_Spec(spec);
+        rebRelease(spec);
+    }
+
+    ParallelJob* jobs = rebAllocN(ParallelJob, num_jobs);
+    ParallelWorker* workers = rebAllocN(ParallelWorker, num_jobs);
+    SQLLEN num_workers = 0;
+
+    Reset_Arena(&g_param_arena);  // for all the jobs' parameters
+
+    for (i = 0; i != num_jobs; ++i) {
+        Value* spec = rebValue("pick jobs", rebI(i + 1));
+        Prepare_Parallel_Job(&jobs[i], spec);
+        rebRelease(spec);
+
+        if (jobs[i].error)
+            continue;
+
+        SQLLEN w;
+        for (w = 0; w != num_workers; ++w) {
+            if (workers[w].conn == jobs[i].conn)
+                break;
+        }
+        if (w == num_workers) {
+            workers[w].conn = jobs[i].conn;
+            workers[w].jobs = jobs;
+            workers[w].num_jobs = num_jobs;
+            workers[w].thread_running = false;
+            ++num_workers;
+        }
+    }
+
+    SQLLEN w;
+    for (w = 1; w < num_workers; ++w) {  // first runs on this thread [1]
+        workers[w].thread_running = Start_Thread(
+            &workers[w].thread, &Parallel_Thread_Function, &workers[w]
+        );
+    }
+    if (num_workers != 0)
+        Run_Parallel_Jobs(&workers[0]);
+    for (w = 1; w < num_workers; ++w) {
+        if (workers[w].thread_running)
+            Join_Thread(workers[w].thread);
+        else
+            Run_Parallel_Jobs(&workers[w]);  // see [1]
+    }
+
+    Value* results = rebValue("make block!", rebI(num_jobs));
+
+    for (i = 0; i != num_jobs; ++i) {  // see [3]
+        ParallelJob* job = &jobs[i];
+
+        if (job->error)
+            rebElide("append", results, rebR(job->error));
+        else if (job->rows.failure)
+            rebElide(
+                "append", results, "make error!", rebT(job->rows.failure)
+            );
+        else if (job->rc != SQL_SUCCESS and job->rc != SQL_NO_DATA)
+            rebElide("append", results, rebR(Error_ODBC_Stmt(job->hstmt)));
+        else if (job->num_columns == 0)
+            rebElide("append", results, rebI(job->row_count));
+        else {
+            Value* rows = rebValue("make block!", rebI(job->rows.num_rows));
+            Append_Row_Block_Values(rows, job->columns, &job->rows, nullptr);
+            rebElide("append:line", results, rebR(rows));
+        }
+
+        Free_Parallel_Job(job);
+    }
+
+    rebFree(workers);
+    rebFree(jobs);
+
+    return results;
+}
+
+
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// DELIMITED TEXT EXPORT
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Dumping a query to a CSV file through COPY-ODBC makes a Rebol value for
+// every cell, only to FORM it back to text.  EXPORT-ODBC instead formats the
+// data fetched into a RowBlock directly as UTF-8, and writes it to the file
+// in large chunks.
+//
+
+#define EXPORT_FLUSH_SIZE  (1024 * 1024)
+
+static bool Append_Bytes(ByteBuffer* b, const void* data, size_t size) {
+    if (not Byte_Buffer_Reserve(b, size))
+        return false;
+    memcpy(b->data + b->size, data, size);
+    b->size += size;
+    return true;
+}
+
+static bool Append_UTF8_Codepoint(ByteBuffer* b, uint32_t c) {
+    unsigned char encoded[4];
+    size_t size;
+    if (c < 0x80) {
+        encoded[0] = cast(unsigned char, c);
+        size = 1;
+    }
+    else if (c < 0x800) {
+        encoded[0] = cast(unsigned char, 0xC0 | (c >> 6));
+        encoded[1] = cast(unsigned char, 0x80 | (c & 0x3F));
+        size = 2;
+    }
+    else if (c < 0x10000) {
+        encoded[0] = cast(unsigned char, 0xE0 | (c >> 12));
+        encoded[1] = cast(unsigned char, 0x80 | ((c >> 6) & 0x3F));
+        encoded[2] = cast(unsigned char, 0x80 | (c & 0x3F));
+        size = 3;
+    }
+    else {
+        encoded[0] = cast(unsigned char, 0xF0 | (c >> 18));
+        encoded[1] = cast(unsigned char, 0x80 | ((c >> 12) & 0x3F));
+        encoded[2] = cast(unsigned char, 0x80 | ((c >> 6) & 0x3F));
+        encoded[3] = cast(unsigned char, 0x80 | (c & 0x3F));
+        size = 4;
+    }
+    return Append_Bytes(b, encoded, size);
+}
+
+// SQL_C_WCHAR data is UTF-16 (see notes in OPEN-CONNECTION).  Unpaired
+// surrogates become U+FFFD, the replacement character.
+//
+static bool Append_UTF16_As_UTF8(
+    ByteBuffer* b,
+    const SQLWCHAR* wide,
+    size_t num_wchars
+){
+    size_t i;
+    for (i = 0; i != num_wchars; ++i) {
+        uint32_t c = wide[i];
+        if (c >= 0xD800 and c <= 0xDBFF) {
+            if (
+                i + 1 != num_wchars
+                and wide[i + 1] >= 0xDC00 and wide[i + 1] <= 0xDFFF
+            ){
+                c = 0x10000 + ((c - 0xD800) << 10) + (wide[i + 1] - 0xDC00);
+                ++i;
+            }
+            else
+                c = 0xFFFD;
+        }
+        else if (c >= 0xDC00 and c <= 0xDFFF)
+            c = 0xFFFD;
+
+        if (not Append_UTF8_Codepoint(b, c))
+            return false;
+    }
+    return true;
+}
+
+static bool Append_Formatted(ByteBuffer* b, const char* format, ...) {
+    char temp[64];
+
+    va_list va;
+    va_start(va, format);
+    int size = vsnprintf(temp, sizeof(temp), format, va);
+    va_end(va);
+
+    assert(size >= 0 and size < cast(int, sizeof(temp)));
+    return Append_Bytes(b, temp, size);
+}
+
+// Shortest of %.15g and %.17g that reads back as the same double, so common
+// values like 5.6 don't come out as 5.5999999999999996.
+//
+static bool Append_Double(ByteBuffer* b, double d) {
+    char temp[32];
+    snprintf(temp, sizeof(temp), "%.15g", d);
+    if (strtod(temp, nullptr) != d)
+        snprintf(temp, sizeof(temp), "%.17g", d);
+    return Append_Bytes(b, temp, strlen(temp));
+}
+
+
+// Append the UTF-8 text form of a fetched (non-NULL) cell to a buffer.
+// Text follows the same CHAR encoding rules as ODBC_Column_To_Rebol_Value().
+// Formats are the ones SQL uses for literals, so a re-import can parse them.
+//
+static bool Append_Cell_As_UTF8(
+    ByteBuffer* b,
+    const Column* col,
+    const void* buffer,
+    SQLLEN len
+){
+    switch (col->c_type) {
+      case SQL_C_BIT:
+        if (*cast(const unsigned char*, buffer))
+            return Append_Bytes(b, "true", 4);
+        return Append_Bytes(b, "false", 5);
+
+      case SQL_C_UTINYINT:
+        return Append_Formatted(b, "%u",
+            cast(unsigned, *cast(const unsigned char*, buffer))
+        );
+
+      case SQL_C_SLONG:
+        return Append_Formatted(b, "%ld",
+            cast(long, *cast(const SQLINTEGER*, buffer))
+        );
+
+      case SQL_C_ULONG:
+        return Append_Formatted(b, "%lu",
+            cast(unsigned long, *cast(const SQLUINTEGER*, buffer))
+        );
+
+      case SQL_C_SBIGINT:
+        return Append_Formatted(b, "%lld",
+            cast(long long, *cast(const SQLBIGINT*, buffer))
+        );
+
+      case SQL_C_UBIGINT:
+        return Append_Formatted(b, "%llu",
+            cast(unsigned long long, *cast(const SQLUBIGINT*, buffer))
+        );
+
+      case SQL_C_DOUBLE:
+        return Append_Double(b, *cast(const SQLDOUBLE*, buffer));
+
+      case SQL_C_TYPE_DATE: {
+        const DATE_STRUCT* date = cast(const DATE_STRUCT*, buffer);
+        return Append_Formatted(b, "%04d-%02u-%02u",
+            date->year, date->month, date->day
+        ); }
+
+      case SQL_C_TYPE_TIME: {
+        const TIME_STRUCT* time = cast(const TIME_STRUCT*, buffer);
+        return Append_Formatted(b, "%02u:%02u:%02u",
+            time->hour, time->minute, time->second
+        ); }
+
+      case SQL_C_TYPE_TIMESTAMP: {
+        const TIMESTAMP_STRUCT* stamp = cast(const TIMESTAMP_STRUCT*, buffer);
+        if (not Append_Formatted(b, "%04d-%02u-%02u %02u:%02u:%02u",
+            stamp->year, stamp->month, stamp->day,
+            stamp->hour, stamp->minute, stamp->second
+        )){
+            return false;
+        }
+        if (stamp->fraction == 0)
+            return true;
+
+        char digits[16];  // nanoseconds, without trailing zeros
+        int size = snprintf(digits, sizeof(digits), ".%09lu",
+            cast(unsigned long, stamp->fraction)
+        );
+        while (digits[size - 1] == '0')
+            --size;
+        return Append_Bytes(b, digits, size); }
+
+      case SQL_C_BINARY: {  // hexadecimal, as in BLOB! literals
+        static const char hex[] = "0123456789ABCDEF";
+        if (not Byte_Buffer_Reserve(b, len * 2))
+            return false;
+        const unsigned char* bytes = cast(const unsigned char*, buffer);
+        SQLLEN i;
+        for (i = 0; i != len; ++i) {
+            b->data[b->size++] = hex[bytes[i] >> 4];
+            b->data[b->size++] = hex[bytes[i] & 0x0F];
+        }
+        return true; }
+
+      case SQL_C_CHAR:
+        if (col->encoding == CHAR_COL_LATIN1) {
+            const unsigned char* latin1 = cast(const unsigned char*, buffer);
+            SQLLEN i;
+            for (i = 0; i != len; ++i) {
+                if (not Append_UTF8_Codepoint(b, latin1[i]))
+                    return false;
+            }
+            return true;
+        }
+        assert(col->encoding == CHAR_COL_UTF8);
+        return Append_Bytes(b, buffer, len);
+
+      case SQL_C_WCHAR:
+        assert(len % 2 == 0);
+        return Append_UTF16_As_UTF8(
+            b, cast(const SQLWCHAR*, buffer), len / 2
+        );
+
+      default:
+        break;
+    }
+
+    return false;  // caller reports unsupported type
+}
+
+
+typedef enum {
+    EXPORT_QUOTE_MINIMAL,  // only fields containing delimiter/quote/newline
+    EXPORT_QUOTE_ALL,  // every field that isn't NULL
+    EXPORT_QUOTE_NONE  // never (caller knows the data is safe)
+} ExportQuoting;
+
+struct ExportStruct {
+    FILE* file;
+    ByteBuffer out;  // flushed to the file when it gets big
+    ByteBuffer field;  // one field's UTF-8, before quoting and encoding
+
+    unsigned char delimiter;
+    unsigned char quote;
+    ExportQuoting quoting;
+    bool latin1;
+    char* null_text;  // UTF-8, compared against fields
+    ByteBuffer null_out;  // null_text in the output encoding, never quoted
+
+    const char* failure;
+};
+typedef struct ExportStruct Export;
+
+static bool Export_Flush(Export* ex) {
+    if (ex->out.size == 0)
+        return true;
+    if (fwrite(ex->out.data, 1, ex->out.size, ex->file) != ex->out.size) {
+        ex->failure = "Error writing EXPORT-ODBC file";
+        return false;
+    }
+    ex->out.size = 0;
+    return true;
+}
+
+// Write ex->field to the output with quoting, in the output encoding.
+//
+static bool Export_Field(Export* ex) {
+    const unsigned char* utf8 = ex->field.data;
+    size_t size = ex->field.size;
+
+    bool quoted = (ex->quoting == EXPORT_QUOTE_ALL);
+    if (ex->quoting == EXPORT_QUOTE_MINIMAL) {
+        quoted = (  // would read back as NULL if unquoted, see EXPORT-ODBC
+            size == 0
+            or (size == strlen(ex->null_text)
+                and memcmp(utf8, ex->null_text, size) == 0)
+        );
+        size_t i;
+        for (i = 0; not quoted and i != size; ++i) {
+            unsigned char c = utf8[i];
+            if (
+                c == ex->delimiter or c == ex->quote
+                or c == '\n' or c == '\r'
+            ){
+                quoted = true;
+            }
+        }
+    }
+
+    if (not Byte_Buffer_Reserve(&ex->out, size * 2 + 2)) {
+        ex->failure = "Out of memory in EXPORT-ODBC";
+        return false;
+    }
+
+    unsigned char* dest = ex->out.data + ex->out.size;
+    if (quoted)
+        *dest++ = ex->quote;
+
+    size_t i;
+    for (i = 0; i != size; ++i) {
+        unsigned char c = utf8[i];
+        if (quoted and c == ex->quote)
+            *dest++ = ex->quote;  // quotes are doubled inside quoted fields
+
+        if (not ex->latin1 or c < 0x80) {
+            *dest++ = c;
+            continue;
+        }
+
+        if ((c & 0xE0) != 0xC0 or i + 1 == size or c > 0xC3) {
+            ex->failure = "Codepoint too high for Latin-1 in EXPORT-ODBC";
+            return false;
+        }
+        *dest++ = cast(unsigned char, ((c & 0x1F) << 6) | (utf8[++i] & 0x3F));
+    }
+
+    if (quoted)
+        *dest++ = ex->quote;
+
+    ex->out.size = dest - ex->out.data;
+    return true;
+}
+
+static bool Export_Row_Block(
+    Export* ex,
+    const Column* columns,
+    const RowBlock* block
+){
+    SQLLEN row;
+    for (row = 0; row != block->num_rows; ++row) {
+        size_t cell = cast(size_t, row) * block->num_columns;
+
+        SQLSMALLINT n;
+        for (n = 0; n != block->num_columns; ++n, ++cell) {
+            if (n != 0 and not Append_Bytes(&ex->out, &ex->delimiter, 1))
+                goto out_of_memory;
+
+            SQLLEN len = block->lengths[cell];
+            if (len == SQL_NULL_DATA) {
+                if (not Append_Bytes(
+                    &ex->out, ex->null_out.data, ex->null_out.size
+                )){
+                    goto out_of_memory;
+                }
+                continue;
+            }
+
+            ex->field.size = 0;
+            if (not Append_Cell_As_UTF8(
+                &ex->field,
+                &columns[n],
+                block->bytes.data + block->offsets[cell],
+                len
+            )){
+                ex->failure = "Unsupported column type in EXPORT-ODBC";
+                return false;
+            }
+            if (not Export_Field(ex))
+                return false;
+        }
+
+        if (not Append_Bytes(&ex->out, "\n", 1))
+            goto out_of_memory;
+
+        if (ex->out.size >= EXPORT_FLUSH_SIZE and not Export_Flush(ex))
+            return false;
+    }
+    return true;
+
+  out_of_memory:
+    ex->failure = "Out of memory in EXPORT-ODBC";
+    return false;
+}
+
+
+//
+//  export /export-odbc: native [
+//
+//  "Write the rest of a result set to a delimited text (e.g. CSV) file"
+//
+//      return: "Number of rows written"
+//          [integer!]
+//      statement [object!]
+//      file [file!]
+//      :delimiter "Field separator, default is comma (use tab for TSV)"
+//          [rune!]
+//      :quote "Character for quoting fields, default is double quote"
+//          [rune!]
+//      :quoting "Which fields get quoted"
+//          [~[minimal all none]~]
+//      :null-as "Text written for NULL, default is empty"
+//          [text!]
+//      :encoding "Encoding of the file, default is UTF-8"
+//          [~[utf-8 latin-1]~]
+//      :header "Write the column titles as the first line"
+//  ]
+//
+DECLARE_NATIVE(EXPORT_ODBC)
+//
+// 1. Only ASCII is accepted for the delimiter and quote, so they can be
+//    compared to bytes of the UTF-8 data.
+//
+// 2. IMPORT-ODBC only takes an *unquoted* field matching :NULL-AS as NULL.
+//    So minimal quoting also quotes a non-NULL field that would read back
+//    as NULL: an empty string (with the default NULL-AS of "") or a string
+//    equal to NULL-AS.  For the same reason NULL-AS itself can't contain
+//    the delimiter, quote or a newline, since it is never quoted.
+//
+// 3. NULL-AS goes through Export_Field() once, unquoted, so it is in the
+//    output encoding (and a non-Latin-1 NULL-AS fails like any field).
+{
+    INCLUDE_PARAMS_OF_EXPORT_ODBC;
+
+    Finish_Prefetch();  // no worker thread may be using a handle
+
+    SQLHSTMT hstmt = rebUnboxHandle(SQLHSTMT,
+        "ensure handle! statement.hstmt"
+    );
+    ColumnList* list = rebUnboxHandle(ColumnList*,
+        "ensure handle! statement.columns"
+    );
+    if (hstmt == SQL_NULL_HANDLE or not list->columns)
+        return "panic -[Invalid statement object!]-";
+
+    Export ex;
+    ex.delimiter = rebUnboxInteger(
+        "to integer! any [delimiter, #\",\"]"
+    );
+    ex.quote = rebUnboxInteger(
+        "to integer! any [quote, #\"\\\"\"]"
+    );
+    if (ex.delimiter >= 0x80 or ex.quote >= 0x80)  // see [1]
+        return "panic -[EXPORT-ODBC delimiter and quote must be ASCII]-";
+
+    ex.quoting = cast(ExportQuoting, rebUnboxInteger(
+        "switch any [quoting, 'minimal] [",
+            "'minimal [", rebI(EXPORT_QUOTE_MINIMAL), "]",
+            "'all [", rebI(EXPORT_QUOTE_ALL), "]",
+            "'none [", rebI(EXPORT_QUOTE_NONE), "]",
+        "]"
+    ));
+    ex.latin1 = rebUnboxLogic("'latin-1 = encoding");
+    ex.failure = nullptr;
+    ex.out.data = ex.field.data = nullptr;
+    ex.out.size = ex.out.capacity = ex.field.size = ex.field.capacity = 0;
+
+  #if TO_WINDOWS
+    SQLWCHAR* path = rebSpellWide("file-to-local:full file");
+    ex.file = _wfopen(cast(wchar_t*, path), L"wb");
+  #else
+    char* path = rebSpell("file-to-local:full file");
+    ex.file = fopen(path, "wb");
+  #endif
+    rebFree(path);
+    if (ex.file == nullptr)
+        return rebDelegate("panic [-[EXPORT-ODBC could not open]- file]");
+
+    ex.null_text = rebSpell("any [null-as, {}]");
+    ex.null_out.data = nullptr;
+    ex.null_out.size = ex.null_out.capacity = 0;
+
+    bool ok = true;
+
+    const char* scan;
+    for (scan = ex.null_text; *scan != '\0'; ++scan) {  // see [2]
+        unsigned char c = cast(unsigned char, *scan);
+        if (
+            c == ex.delimiter or c == ex.quote or c == '\n' or c == '\r'
+        ){
+            ok = false;
+            ex.failure = "EXPORT-ODBC :NULL-AS can't need quoting";
+            break;
+        }
+    }
+
+    if (ok) {  // see [3]
+        ExportQuoting quoting = ex.quoting;
+        ex.quoting = EXPORT_QUOTE_NONE;
+        ex.field.size = 0;
+        ok = Append_Bytes(&ex.field, ex.null_text, strlen(ex.null_text))
+            and Export_Field(&ex)
+            and Append_Bytes(&ex.null_out, ex.out.data, ex.out.size);
+        ex.out.size = 0;
+        ex.quoting = quoting;
+        if (not ok and not ex.failure)
+            ex.failure = "Out of memory in EXPORT-ODBC";
+    }
+
+    if (ok and rebUnboxLogic("header")) {
+        SQLLEN n;
+        for (n = 0; ok and n != list->num_columns; ++n) {
+            if (n != 0)
+                ok = Append_Bytes(&ex.out, &ex.delimiter, 1);
+
+            size_t size;
+            unsigned char* title = rebBytes(&size, list->columns[n].title);
+            ex.field.size = 0;
+            ok = ok and Append_Bytes(&ex.field, title, size);
+            rebFree(title);
+            ok = ok and Export_Field(&ex);
+        }
+        ok = ok and Append_Bytes(&ex.out, "\n", 1);
+        if (not ok and not ex.failure)
+            ex.failure = "Out of memory in EXPORT-ODBC";
+    }
+
+    RowBlock block;
+    Init_Row_Block(&block, list->num_columns);
+
+    SQLLEN num_rows = 0;
+    while (ok) {
+        Fetch_Rows_Raw(hstmt, list->columns, &block, 1024);
+        if (block.rc != SQL_SUCCESS and block.rc != SQL_NO_DATA)
+            break;
+
+        ok = Export_Row_Block(&ex, list->columns, &block);
+        num_rows += block.num_rows;
+
+        if (block.rc == SQL_NO_DATA)
+            break;
+    }
+
+    ok = ok and Export_Flush(&ex);
+
+    if (fclose(ex.file) != 0 and ok) {
+        ok = false;
+        ex.failure = "Error closing EXPORT-ODBC file";
+    }
+
+    Free_Byte_Buffer(&ex.out);
+    Free_Byte_Buffer(&ex.field);
+    Free_Byte_Buffer(&ex.null_out);
+    rebFree(ex.null_text);
+
+    Value* error = nullptr;
+    if (not ok)
+        error = rebValue("make error!", rebT(ex.failure));
+    else if (block.failure)
+        error = rebValue("make error!", rebT(block.failure));
+    else if (block.rc != SQL_SUCCESS and block.rc != SQL_NO_DATA)
+        error = Error_ODBC_Stmt(hstmt);
+
+    Free_Row_Block(&block);
+
+    if (error)
+        return rebDelegate("panic", rebR(error));
+
+    return rebInteger(num_rows);
+}
+
+
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// DELIMITED TEXT IMPORT
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Loading a CSV file by parsing it in Rebol and calling INSERT-ODBC for each
+// row makes values for every field and binds fresh parameter buffers for
+// every row.  IMPORT-ODBC parses the file in C, converts the fields of a
+// batch of rows into column-wise parameter arrays, and runs the prepared
+// INSERT once per batch with SQL_ATTR_PARAMSET_SIZE.
+//
+// Rows that can't be parsed or converted, or which the driver reports as
+// failing in SQL_ATTR_PARAM_STATUS_PTR, are rejected by line number instead
+// of stopping the whole load.
+//
+
+#define IMPORT_CHUNK_SIZE  (1024 * 1024)
+
+typedef enum {
+    IMPORT_TEXT,
+    IMPORT_INTEGER,
+    IMPORT_DECIMAL,
+    IMPORT_DATE,
+    IMPORT_TIMESTAMP
+} ImportType;
+
+struct ImportFieldStruct {
+    size_t offset;  // unescaped contents are in the importer's `text`
+    size_t size;
+    bool quoted;
+};
+typedef struct ImportFieldStruct ImportField;
+
+struct ImportRowStruct {
+    SQLLEN line;  // line of the file the record starts on
+    size_t first_field;  // index into the importer's `fields`
+    SQLSMALLINT num_fields;
+    bool bad;  // malformed quoting
+};
+typedef struct ImportRowStruct ImportRow;
+
+struct ImportColumnStruct {
+    ImportType type;
+    ByteBuffer values;  // batch_size elements of `width` bytes each
+    SQLLEN width;
+    SQLLEN* lengths;  // batch_size length/indicator values
+};
+typedef struct ImportColumnStruct ImportColumn;
+
+struct ImporterStruct {
+    FILE* file;
+    ByteBuffer in;  // bytes read from the file and not yet parsed
+    size_t pos;
+    bool eof;
+    SQLLEN line;  // line number at `pos`
+
+    unsigned char delimiter;
+    unsigned char quote;
+    char* null_as;  // nullptr if only empty unquoted fields are NULL
+
+    ByteBuffer text;  // fields of the batch's rows, unescaped
+    ByteBuffer fields;  // ImportField array
+    ByteBuffer rows;  // ImportRow array
+
+    SQLSMALLINT num_columns;
+    ImportColumn* columns;
+    SQLLEN batch_size;
+    SQLLEN* lines;  // line of each row in the parameter arrays
+    SQLUSMALLINT* statuses;
+    SQLULEN processed;
+
+    const char* failure;
+};
+typedef struct ImporterStruct Importer;
+
+typedef enum {
+    PARSE_RECORD,
+    PARSE_NEED_INPUT,
+    PARSE_END
+} ParseResult;
+
+
+// Keep any unparsed bytes, and add the next chunk of the file after them.
+//
+static bool Import_Read_Chunk(Importer* im) {
+    size_t remaining = im->in.size - im->pos;
+    if (remaining != 0 and im->pos != 0)
+        memmove(im->in.data, im->in.data + im->pos, remaining);
+    im->in.size = remaining;
+    im->pos = 0;
+
+    if (not Byte_Buffer_Reserve(&im->in, IMPORT_CHUNK_SIZE)) {
+        im->failure = "Out of memory in IMPORT-ODBC";
+        return false;
+    }
+
+    size_t got = fread(
+        im->in.data + im->in.size, 1, IMPORT_CHUNK_SIZE, im->file
+    );
+    im->in.size += got;
+    if (got < IMPORT_CHUNK_SIZE) {
+        if (ferror(im->file)) {
+            im->failure = "Error reading IMPORT-ODBC file";
+            return false;
+        }
+        im->eof = true;
+    }
+    return true;
+}
+
+
+// Parse one record at `pos` into the importer's fields and text, following
+// RFC 4180: quoted fields may contain delimiters and newlines, and a doubled
+// quote inside is one quote.  If the record isn't complete in the buffer (and
+// the file has more), nothing is added and PARSE_NEED_INPUT is returned.
+//
+// 1. Blank lines are skipped, instead of being a row with one empty field.
+//
+static ParseResult Parse_Record(Importer* im, ImportRow* row) {
+    const unsigned char* data = im->in.data;
+    size_t end = im->in.size;
+    size_t p = im->pos;
+
+    while (p != end and (data[p] == '\n' or data[p] == '\r')) {  // see [1]
+        if (data[p] == '\r' and p + 1 == end and not im->eof)
+            return PARSE_NEED_INPUT;  // can't tell if \n follows yet
+        if (data[p] == '\n' or p + 1 == end or data[p + 1] != '\n')
+            ++im->line;
+        ++p;
+    }
+    im->pos = p;
+
+    if (p == end)
+        return im->eof ? PARSE_END : PARSE_NEED_INPUT;
+
+    size_t text_mark = im->text.size;
+    size_t fields_mark = im->fields.size;
+    SQLLEN lines = 0;
+
+    row->line = im->line;
+    row->first_field = im->fields.size / sizeof(ImportField);
+    row->num_fields = 0;
+    row->bad = false;
+
+    while (true) {
+        ImportField field;
+        field.offset = im->text.size;
+        field.quoted = false;
+
+        if (p != end and data[p] == im->quote) {
+            field.quoted = true;
+            ++p;
+            while (true) {
+                const unsigned char* found = cast(const unsigned char*,
+                    memchr(data + p, im->quote, end - p)
+                );
+                size_t run = (found ? cast(size_t, found - data) : end) - p;
+
+                size_t i;
+                for (i = 0; i != run; ++i) {
+                    if (data[p + i] == '\n')
+                        ++lines;
+                }
+                if (not Append_Bytes(&im->text, data + p, run))
+                    goto out_of_memory;
+                p += run;
+
+                if (p == end) {
+                    if (not im->eof)
+                        goto need_input;
+                    row->bad = true;  // unterminated quote
+                    break;
+                }
+                if (p + 1 == end and not im->eof)
+                    goto need_input;  // can't tell if quote is doubled yet
+
+                if (p + 1 != end and data[p + 1] == im->quote) {
+                    if (not Append_Bytes(&im->text, &im->quote, 1))
+                        goto out_of_memory;
+                    p += 2;
+                    continue;
+                }
+                ++p;  // closing quote
+                break;
+            }
+        }
+        else {
+            size_t start = p;
+            while (
+                p != end and data[p] != im->delimiter
+                and data[p] != '\n' and data[p] != '\r'
+            ){
+                ++p;
+            }
+            if (p == end and not im->eof)
+                goto need_input;
+            if (not Append_Bytes(&im->text, data + start, p - start))
+                goto out_of_memory;
+        }
+
+        field.size = im->text.size - field.offset;
+        if (not Append_Bytes(&im->fields, &field, sizeof(ImportField)))
+            goto out_of_memory;
+        ++row->num_fields;
+
+        if (p == end)  // last line of the file had no newline
+            break;
+
+        if (data[p] == im->delimiter) {
+            ++p;
+            continue;
+        }
+        if (data[p] == '\r') {
+            if (p + 1 == end and not im->eof)
+                goto need_input;
+            ++p;
+            if (p != end and data[p] == '\n')
+                ++p;
+            ++lines;
+            break;
+        }
+        if (data[p] == '\n') {
+            ++p;
+            ++lines;
+            break;
+        }
+
+        row->bad = true;  // text after a closing quote, skip rest of line
+        while (p != end and data[p] != '\n')
+            ++p;
+        if (p == end and not im->eof)
+            goto need_input;
+        if (p != end) {
+            ++p;
+            ++lines;
+        }
+        break;
+    }
+
+    im->pos = p;
+    im->line += lines;
+    return PARSE_RECORD;
+
+  need_input:
+    im->text.size = text_mark;
+    im->fields.size = fields_mark;
+    return PARSE_NEED_INPUT;
+
+  out_of_memory:
+    im->failure = "Out of memory in IMPORT-ODBC";
+    im->text.size = text_mark;
+    im->fields.size = fields_mark;
+    return PARSE_END;
+}
+
+
+// Returns number of UTF-16 units written, or -1 if the UTF-8 is invalid.
+// The output needs room for as many units as there are input bytes.
+//
+static SQLLEN UTF8_To_UTF16(
+    SQLWCHAR* out,
+    const unsigned char* utf8,
+    size_t size
+){
+    SQLLEN num_wchars = 0;
+    size_t i = 0;
+    while (i != size) {
+        uint32_t c = utf8[i];
+        size_t trail;
+        if (c < 0x80)
+            trail = 0;
+        else if ((c & 0xE0) == 0xC0) {
+            trail = 1;
+            c &= 0x1F;
+        }
+        else if ((c & 0xF0) == 0xE0) {
+            trail = 2;
+            c &= 0x0F;
+        }
+        else if ((c & 0xF8) == 0xF0) {
+            trail = 3;
+            c &= 0x07;
+        }
+        else
+            return -1;
+
+        if (size - i <= trail)
+            return -1;
+
+        size_t n;
+        for (n = 1; n <= trail; ++n) {
+            if ((utf8[i + n] & 0xC0) != 0x80)
+                return -1;
+            c = (c << 6) | (utf8[i + n] & 0x3F);
+        }
+        i += trail + 1;
+
+        if (c >= 0x10000) {
+            if (c > 0x10FFFF)
+                return -1;
+            c -= 0x10000;
+            out[num_wchars++] = cast(SQLWCHAR, 0xD800 + (c >> 10));
+            out[num_wchars++] = cast(SQLWCHAR, 0xDC00 + (c & 0x3FF));
+        }
+        else
+            out[num_wchars++] = cast(SQLWCHAR, c);
+    }
+    return num_wchars;
+}
+
+// Parse all of a field as a number, with the strtoXXX() function's rules.
+//
+static bool Import_Number(
+    ImportType type,
+    const unsigned char* text,
+    size_t size,
+    void* out
+){
+    char temp[64];
+    if (size == 0 or size >= sizeof(temp))
+        return false;
+    memcpy(temp, text, size);
+    temp[size] = '\0';
+
+    char* parsed_end;
+    errno = 0;
+    if (type == IMPORT_INTEGER)
+        *cast(SQLBIGINT*, out) = strtoll(temp, &parsed_end, 10);
+    else
+        *cast(SQLDOUBLE*, out) = strtod(temp, &parsed_end);
+
+    return errno == 0 and parsed_end == temp + size;
+}
+
+// Reads exactly `digits` decimal digits.
+//
+static bool Import_Digits(
+    const unsigned char** text,
+    const unsigned char* end,
+    int digits,
+    int* out
+){
+    *out = 0;
+    for (; digits != 0; --digits, ++*text) {
+        if (*text == end or **text < '0' or **text > '9')
+            return false;
+        *out = *out * 10 + (**text - '0');
+    }
+    return true;
+}
+
+// Dates are YYYY-MM-DD, timestamps add " HH:MM:SS" (or T instead of space)
+// and optionally a fraction of a second.  These are the formats EXPORT-ODBC
+// writes.
+//
+static bool Import_Date(
+    ImportType type,
+    const unsigned char* text,
+    size_t size,
+    void* out
+){
+    const unsigned char* end = text + size;
+    int year, month, day;
+    if (
+        not Import_Digits(&text, end, 4, &year)
+        or text == end or *text++ != '-'
+        or not Import_Digits(&text, end, 2, &month)
+        or text == end or *text++ != '-'
+        or not Import_Digits(&text, end, 2, &day)
+        or month < 1 or month > 12 or day < 1 or day > 31
+    ){
+        return false;
+    }
+
+    if (type == IMPORT_DATE) {
+        DATE_STRUCT* date = cast(DATE_STRUCT*, out);
+        date->year = year;
+        date->month = month;
+        date->day = day;
+        return text == end;
+    }
+
+    int hour, minute, second;
+    if (
+        text == end or (*text != ' ' and *text != 'T')
+        or (++text, not Import_Digits(&text, end, 2, &hour))
+        or text == end or *text++ != ':'
+        or not Import_Digits(&text, end, 2, &minute)
+        or text == end or *text++ != ':'
+        or not Import_Digits(&text, end, 2, &second)
+        or hour > 23 or minute > 59 or second > 60
+    ){
+        return false;
+    }
+
+    unsigned long fraction = 0;  // nanoseconds
+    if (text != end) {
+        if (*text++ != '.' or text == end)
+            return false;
+        int digits = 0;
+        for (; text != end; ++text, ++digits) {
+            if (*text < '0' or *text > '9' or digits == 9)
+                return false;
+            fraction = fraction * 10 + (*text - '0');
+        }
+        for (; digits != 9; ++digits)
+            fraction *= 10;
+    }
+
+    TIMESTAMP_STRUCT* stamp = cast(TIMESTAMP_STRUCT*, out);
+    stamp->year = year;
+    stamp->month = month;
+    stamp->day = day;
+    stamp->hour = hour;
+    stamp->minute = minute;
+    stamp->second = second;
+    stamp->fraction = fraction;
+    return true;
+}
+
+
+// Convert the parsed rows into the parameter arrays.  Rows that don't have
+// the right number of fields or that don't convert are rejected here, and
+// the rest are packed together.  Returns how many rows were packed.
+//
+static SQLLEN Import_Fill_Parameters(Importer* im, Value* rejected) {
+    const ImportRow* rows = cast(const ImportRow*, im->rows.data);
+    SQLLEN num_rows = im->rows.size / sizeof(ImportRow);
+    const ImportField* fields = cast(const ImportField*, im->fields.data);
+
+    SQLSMALLINT c;
+    for (c = 0; c != im->num_columns; ++c) {
+        ImportColumn* col = &im->columns[c];
+        switch (col->type) {
+          case IMPORT_TEXT: {  // widest field in the batch decides
+            size_t widest = 0;
+            SQLLEN r;
+            for (r = 0; r != num_rows; ++r) {
+                if (rows[r].bad or rows[r].num_fields != im->num_columns)
+                    continue;
+                size_t size = fields[rows[r].first_field + c].size;
+                if (size > widest)
+                    widest = size;
+            }
+            col->width = (widest + 1) * sizeof(SQLWCHAR);
+            break; }
+
+          case IMPORT_INTEGER:
+            col->width = sizeof(SQLBIGINT);
+            break;
+
+          case IMPORT_DECIMAL:
+            col->width = sizeof(SQLDOUBLE);
+            break;
+
+          case IMPORT_DATE:
+            col->width = sizeof(DATE_STRUCT);
+            break;
+
+          case IMPORT_TIMESTAMP:
+            col->width = sizeof(TIMESTAMP_STRUCT);
+            break;
+        }
+
+        col->values.size = 0;
+        if (not Byte_Buffer_Reserve(&col->values, col->width * num_rows)) {
+            im->failure = "Out of memory in IMPORT-ODBC";
+            return 0;
+        }
+    }
+
+    SQLLEN packed = 0;
+    SQLLEN r;
+    for (r = 0; r != num_rows; ++r) {
+        const ImportRow* row = &rows[r];
+        bool ok = not row->bad and row->num_fields == im->num_columns;
+
+        for (c = 0; ok and c != im->num_columns; ++c) {
+            ImportColumn* col = &im->columns[c];
+            const ImportField* field = &fields[row->first_field + c];
+            const unsigned char* text = im->text.data + field->offset;
+            void* out = col->values.data + packed * col->width;
+
+            bool is_null;
+            if (field->quoted)
+                is_null = false;
+            else if (im->null_as)
+                is_null = (
+                    field->size == strlen(im->null_as)
+                    and memcmp(text, im->null_as, field->size) == 0
+                );
+            else
+                is_null = (field->size == 0);
+
+            if (is_null) {
+                col->lengths[packed] = SQL_NULL_DATA;
+                continue;
+            }
+
+            switch (col->type) {
+              case IMPORT_TEXT: {
+                SQLLEN num_wchars = UTF8_To_UTF16(
+                    cast(SQLWCHAR*, out), text, field->size
+                );
+                ok = (num_wchars >= 0);
+                col->lengths[packed] = num_wchars * sizeof(SQLWCHAR);
+                break; }
+
+              case IMPORT_INTEGER:
+              case IMPORT_DECIMAL:
+                ok = Import_Number(col->type, text, field->size, out);
+                col->lengths[packed] = col->width;
+                break;
+
+              case IMPORT_DATE:
+              case IMPORT_TIMESTAMP:
+                ok = Import_Date(col->type, text, field->size, out);
+                col->lengths[packed] = col->width;
+                break;
+            }
+        }
+
+        if (not ok) {
+            rebElide("append", rejected, rebI(row->line));
+            continue;
+        }
+        im->lines[packed] = row->line;
+        ++packed;
+    }
+
+    return packed;
+}
+
+
+static SQLRETURN Import_Bind_Parameters(SQLHSTMT hstmt, Importer* im) {
+    SQLSMALLINT c;
+    for (c = 0; c != im->num_columns; ++c) {
+        ImportColumn* col = &im->columns[c];
+
+        SQLSMALLINT c_type;
+        SQLSMALLINT sql_type;
+        SQLULEN column_size = 0;
+        switch (col->type) {
+          case IMPORT_TEXT:
+            c_type = SQL_C_WCHAR;
+            sql_type = SQL_WVARCHAR;
+            column_size = col->width / sizeof(SQLWCHAR);
+            break;
+
+          case IMPORT_INTEGER:
+            c_type = SQL_C_SBIGINT;
+            sql_type = SQL_BIGINT;
+            break;
+
+          case IMPORT_DECIMAL:
+            c_type = SQL_C_DOUBLE;
+            sql_type = SQL_DOUBLE;
+            break;
+
+          case IMPORT_DATE:
+            c_type = SQL_C_TYPE_DATE;
+            sql_type = SQL_TYPE_DATE;
+            break;
+
+          default:
+            assert(col->type == IMPORT_TIMESTAMP);
+            c_type = SQL_C_TYPE_TIMESTAMP;
+            sql_type = SQL_TYPE_TIMESTAMP;
+            break;
+        }
+
+        SQLRETURN rc = SQLBindParameter(
+            hstmt,  // StatementHandle
+            c + 1,  // ParameterNumber
+            SQL_PARAM_INPUT,  // InputOutputType
+            c_type,  // ValueType
+            sql_type,  // ParameterType
+            column_size,  // ColumnSize
+            0,  // DecimalDigits
+            col->values.data,  // ParameterValuePtr (array of values)
+            col->width,  // BufferLength (of each element)
+            col->lengths  // StrLen_Or_IndPtr (array of lengths)
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rc;
+    }
+    return SQL_SUCCESS;
+}
+
+
+//
+//  export /import-odbc: native [
+//
+//  "Load a delimited text (e.g. CSV) file using batched array INSERTs"
+//
+//      return: "LOADED count of rows, REJECTED line numbers of the file"
+//          [object!]
+//      statement [object!]
+//      sql "INSERT statement with one ? for each field of the file"
+//          [text!]
+//      file [file!]
+//      :types "Per field: text (default), integer, decimal, date, timestamp"
+//          [block!]
+//      :delimiter "Field separator, default is comma (use tab for TSV)"
+//          [rune!]
+//      :quote "Character for quoting fields, default is double quote"
+//          [rune!]
+//      :null-as "Unquoted field text that means NULL, default is empty"
+//          [text!]
+//      :header "Skip the first line of the file"
+//      :batch "Rows per execution, default is 1000"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(IMPORT_ODBC)
+//
+// 1. Drivers that don't support parameter arrays refuse the PARAMSET_SIZE,
+//    so fall back on executing row by row (still with no per-row binding).
+//    The connection remembers this, so later imports don't ask again.
+//
+// 2. If the driver fails the whole SQLExecute() without marking any rows in
+//    the status array, it's not a problem with particular rows.
+//
+// 3. Rows the driver didn't get to (SQL_PARAM_UNUSED) after an error weren't
+//    loaded either, so they are reported as rejected.  But not all drivers
+//    fill in the status array (e.g. without parameter arrays, see [1]), so
+//    when SQLExecute() succeeds the rows still UNUSED were loaded.
+//
+// 4. A batch with rejected rows packs fewer rows than :BATCH, and the batch
+//    after it may be full again.  PARAMSET_SIZE has to be set back, or the
+//    driver would only run the first rows (leaving the rest UNUSED).
+//
+// 5. Like INSERT-ODBC, drop ODBC-EXECUTE:CACHE results of the table loaded.
+{
+    INCLUDE_PARAMS_OF_IMPORT_ODBC;
+
+    Finish_Prefetch();  // no worker thread may be using a handle
+
+    SQLHSTMT hstmt = rebUnboxHandle(SQLHSTMT,
+        "ensure handle! statement.hstmt"
+    );
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! statement.database.hdbc"
+    );
+
+    SQLRETURN rc;
+    rc = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);  // !!! check rc?
+    rc = SQLCloseCursor(hstmt);  // !!! check rc?
+    UNUSED(rc);
+
+    Importer im;
+    im.delimiter = rebUnboxInteger(
+        "to integer! any [delimiter, #\",\"]"
+    );
+    im.quote = rebUnboxInteger(
+        "to integer! any [quote, #\"\\\"\"]"
+    );
+    if (im.delimiter >= 0x80 or im.quote >= 0x80)
+        return "panic -[IMPORT-ODBC delimiter and quote must be ASCII]-";
+
+    im.batch_size = rebUnboxInteger("any [batch, 1000]");
+    if (im.batch_size < 1)
+        return "panic -[IMPORT-ODBC :BATCH must be at least 1]-";
+
+    rebElide("statement.string: null");  // INSERT-ODBC must prepare again
+    rebElide("invalidate-result-cache sql");  // see [5]
+
+    SQLWCHAR* sql_string = rebSpellWide("sql");
+    rc = SQLPrepareW(hstmt, sql_string, SQL_NTS);
+    rebFree(sql_string);
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+
+    rc = SQLNumParams(hstmt, &im.num_columns);
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+    if (im.num_columns == 0)
+        return "panic -[IMPORT-ODBC needs SQL with ? for each field]-";
+
+    rebElide(
+        "if all [types, (length of types) >", rebI(im.num_columns), "] [",
+            "panic -[IMPORT-ODBC :TYPES has more types than SQL has ?]-",
+        "]"
+    );
+
+    im.columns = rebAllocN(ImportColumn, im.num_columns);
+    im.lines = rebAllocN(SQLLEN, im.batch_size);
+    im.statuses = rebAllocN(SQLUSMALLINT, im.batch_size);
+
+    SQLSMALLINT c;
+    for (c = 0; c != im.num_columns; ++c) {
+        ImportColumn* col = &im.columns[c];
+        col->type = cast(ImportType, rebUnboxInteger(
+            "switch any [if types [pick types", rebI(c + 1), "], 'text] [",
+                "'text [", rebI(IMPORT_TEXT), "]",
+                "'integer [", rebI(IMPORT_INTEGER), "]",
+                "'decimal [", rebI(IMPORT_DECIMAL), "]",
+                "'date [", rebI(IMPORT_DATE), "]",
+                "'timestamp [", rebI(IMPORT_TIMESTAMP), "]",
+            "] else [",
+                "panic -[IMPORT-ODBC :TYPES are TEXT, INTEGER, DECIMAL,",
+                    " DATE, or TIMESTAMP]-",
+            "]"
+        ));
+        col->values.data = nullptr;
+        col->values.size = col->values.capacity = 0;
+        col->width = 0;
+        col->lengths = rebAllocN(SQLLEN, im.batch_size);
+    }
+
+  #if TO_WINDOWS
+    SQLWCHAR* path = rebSpellWide("file-to-local:full file");
+    im.file = _wfopen(cast(wchar_t*, path), L"rb");
+  #else
+    char* path = rebSpell("file-to-local:full file");
+    im.file = fopen(path, "rb");
+  #endif
+    rebFree(path);
+    if (im.file == nullptr)
+        return rebDelegate("panic [-[IMPORT-ODBC could not open]- file]");
+
+    im.in.data = im.text.data = im.fields.data = im.rows.data = nullptr;
+    im.in.size = im.text.size = im.fields.size = im.rows.size = 0;
+    im.in.capacity = im.text.capacity = 0;
+    im.fields.capacity = im.rows.capacity = 0;
+    im.pos = 0;
+    im.eof = false;
+    im.line = 1;
+    im.null_as = rebSpellOpt("null-as");
+    im.failure = nullptr;
+
+    Value* rejected = rebValue("copy []");
+    SQLLEN loaded = 0;
+    Value* error = nullptr;
+
+    if (  // see [1]
+        not conn->caps.param_arrays
+        or not SQL_SUCCEEDED(SQLSetStmtAttr(
+            hstmt, SQL_ATTR_PARAM_BIND_TYPE,
+            p_cast(SQLPOINTER, cast(uintptr_t, SQL_PARAM_BIND_BY_COLUMN)), 0
+        ))
+        or not SQL_SUCCEEDED(SQLSetStmtAttr(
+            hstmt, SQL_ATTR_PARAMSET_SIZE,
+            p_cast(SQLPOINTER, cast(uintptr_t, im.batch_size)), 0
+        ))
+    ){
+        if (im.batch_size > 1)
+            conn->caps.param_arrays = false;
+        im.batch_size = 1;
+    }
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, im.statuses, 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &im.processed, 0);
+
+    SQLLEN paramset_size = im.batch_size;  // as last set, see [4]
+
+    bool skip_header = rebUnboxLogic("header");
+
+    if (not Import_Read_Chunk(&im))
+        goto finished;
+    if (
+        im.in.size >= 3 and im.in.data[0] == 0xEF
+        and im.in.data[1] == 0xBB and im.in.data[2] == 0xBF
+    ){
+        im.pos = 3;  // skip UTF-8 byte order mark
+    }
+
+    while (true) {
+        ParseResult result = PARSE_RECORD;
+        SQLLEN num_rows = 0;
+
+        im.text.size = im.fields.size = im.rows.size = 0;
+
+        while (num_rows != im.batch_size) {
+            ImportRow row;
+            result = Parse_Record(&im, &row);
+            if (im.failure)
+                goto finished;
+
+            if (result == PARSE_NEED_INPUT) {
+                if (not Import_Read_Chunk(&im))
+                    goto finished;
+                continue;
+            }
+            if (result == PARSE_END)
+                break;
+
+            if (skip_header) {
+                skip_header = false;
+                im.text.size = im.fields.size = 0;
+                continue;
+            }
+            if (not Append_Bytes(&im.rows, &row, sizeof(ImportRow))) {
+                im.failure = "Out of memory in IMPORT-ODBC";
+                goto finished;
+            }
+            ++num_rows;
+        }
+
+        SQLLEN packed = Import_Fill_Parameters(&im, rejected);
+        if (im.failure)
+            goto finished;
+
+        if (packed != 0) {
+            if (packed != paramset_size) {  // see [4]
+                rc = SQLSetStmtAttr(
+                    hstmt, SQL_ATTR_PARAMSET_SIZE,
+                    p_cast(SQLPOINTER, cast(uintptr_t, packed)), 0
+                );
+                if (not SQL_SUCCEEDED(rc)) {
+                    error = Error_ODBC_Stmt(hstmt);
+                    goto finished;
+                }
+                paramset_size = packed;
+            }
+
+            rc = Import_Bind_Parameters(hstmt, &im);
+            if (not SQL_SUCCEEDED(rc)) {
+                error = Error_ODBC_Stmt(hstmt);
+                goto finished;
+            }
+
+            SQLLEN i;
+            for (i = 0; i != packed; ++i)
+                im.statuses[i] = SQL_PARAM_UNUSED;
+            im.processed = 0;
+
+            rc = SQLExecute(hstmt);
+
+            bool failed = (rc != SQL_SUCCESS and rc != SQL_SUCCESS_WITH_INFO);
+            if (failed) {
+                bool any_marked = false;  // see [2]
+                for (i = 0; i != packed; ++i) {
+                    if (im.statuses[i] == SQL_PARAM_ERROR)
+                        any_marked = true;
+                }
+                if (rc != SQL_NO_DATA and not any_marked) {
+                    error = Error_ODBC_Stmt(hstmt);
+                    goto finished;
+                }
+            }
+
+            for (i = 0; i != packed; ++i) {
+                switch (im.statuses[i]) {
+                  case SQL_PARAM_ERROR:
+                    rebElide("append", rejected, rebI(im.lines[i]));
+                    break;
+
+                  case SQL_PARAM_UNUSED:  // see [3]
+                    if (failed)
+                        rebElide("append", rejected, rebI(im.lines[i]));
+                    else
+                        ++loaded;
+                    break;
+
+                  default:
+                    ++loaded;
+                    break;
+                }
+            }
+
+            if (g_num_batching_connections != 0) {
+                if (not Commit_If_Batch_Full(conn)) {
+                    error = Error_ODBC_Dbc(conn->hdbc);
+                    goto finished;
+                }
+            }
+        }
+
+        if (result == PARSE_END)
+            break;
+    }
+
+  finished: {
+
+    SQLSetStmtAttr(
+        hstmt, SQL_ATTR_PARAMSET_SIZE,
+        p_cast(SQLPOINTER, cast(uintptr_t, 1)), 0
+    );
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, nullptr, 0);
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+
+    fclose(im.file);
+    Free_Byte_Buffer(&im.in);
+    Free_Byte_Buffer(&im.text);
+    Free_Byte_Buffer(&im.fields);
+    Free_Byte_Buffer(&im.rows);
+    for (c = 0; c != im.num_columns; ++c) {
+        Free_Byte_Buffer(&im.columns[c].values);
+        rebFree(im.columns[c].lengths);
+    }
+    rebFree(im.columns);
+    rebFree(im.lines);
+    rebFree(im.statuses);
+    if (im.null_as)
+        rebFree(im.null_as);
+
+    if (im.failure and not error)
+        error = rebValue("make error!", rebT(im.failure));
+
+    if (error) {
+        rebRelease(rejected);
+        return rebDelegate("panic", rebR(error));
+    }
+
+    return rebValue(
+        "make object! [",
+            "loaded:", rebI(loaded),
+            "rejected:", rebR(rejected),
+        "]"
+    );
+}}
+
+
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// ARROW IPC EXPORT
+//
+//=////////////////////////////////////////////////////////////////////////=//
+//
+// Apache Arrow's IPC stream format is a columnar binary format that many
+// analytics tools read directly.  A stream is a Schema message, then any
+// number of RecordBatch messages, then an end-of-stream marker:
+//
+//    https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format
+//
+// Each message is 0xFFFFFFFF, a 32-bit metadata size, the metadata as a
+// FlatBuffer, and then the message body (the column buffers).  Only a few
+// FlatBuffer tables are needed, so rather than depend on the Arrow or
+// FlatBuffers libraries this writes them by hand.
+//
+
+#define ARROW_DEFAULT_BATCH_ROWS  65536
+#define ARROW_BIND_ARRAY_ROWS  1024
+
+typedef enum {  // `Type` union in Schema.fbs
+    ARROW_INT = 2,
+    ARROW_FLOATING_POINT = 3,
+    ARROW_BINARY = 4,
+    ARROW_UTF8 = 5,
+    ARROW_BOOL = 6,
+    ARROW_DATE = 8,
+    ARROW_TIME = 9,
+    ARROW_TIMESTAMP = 10
+} ArrowTypeId;
+
+
+//=//// MINIMAL FLATBUFFER WRITER /////////////////////////////////////////=//
+//
+// FlatBuffers are normally built back to front, but since offsets to child
+// objects are unsigned (children come after what refers to them) they can
+// also be written front to back, patching in each offset once the child's
+// position is known.  Vtables are written just before their table.
+//
+// 1. Fields are laid out largest first after the table's vtable offset, so
+//    the 8-byte fields are aligned if the table is.
+
+struct FlatBuilderStruct {
+    ByteBuffer b;
+    bool ok;  // false if an allocation failed (writes are then ignored)
+};
+typedef struct FlatBuilderStruct FlatBuilder;
+
+struct FbFieldStruct {
+    int size;  // 0 if field is absent, offsets are 4 (filled in later)
+    uint64_t value;
+};
+typedef struct FbFieldStruct FbField;
+
+static void Fb_Raw(FlatBuilder* fb, const void* data, size_t size) {
+    if (fb->ok and not Append_Bytes(&fb->b, data, size))
+        fb->ok = false;
+}
+
+static void Put_Little_Endian(unsigned char* dest, uint64_t value, int size) {
+    int i;
+    for (i = 0; i != size; ++i)
+        dest[i] = cast(unsigned char, value >> (8 * i));
+}
+
+static void Fb_Scalar(FlatBuilder* fb, uint64_t value, int size) {
+    unsigned char temp[8];
+    Put_Little_Endian(temp, value, size);
+    Fb_Raw(fb, temp, size);
+}
+
+static void Fb_Pad(FlatBuilder* fb, size_t alignment) {
+    static const unsigned char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    Fb_Raw(fb, zeros, (alignment - fb->b.size % alignment) % alignment);
+}
+
+// Point the offset field at `field_pos` to `target` (which comes after it).
+//
+static void Fb_Offset(FlatBuilder* fb, size_t field_pos, size_t target) {
+    if (fb->ok)
+        Put_Little_Endian(fb->b.data + field_pos, target - field_pos, 4);
+}
+
+// Returns position of the table, and where each field was put in `pos`.
+//
+static size_t Fb_Table(
+    FlatBuilder* fb,
+    const FbField* fields,
+    int num_fields,
+    size_t* pos
+){
+    uint16_t offsets[8];
+    assert(num_fields <= 8);
+
+    size_t table_size = 4;  // soffset_t to the vtable
+    int size;
+    for (size = 8; size != 0; size /= 2) {  // see [1]
+        int i;
+        for (i = 0; i != num_fields; ++i) {
+            if (fields[i].size != size)
+                continue;
+            table_size = (table_size + size - 1) / size * size;
+            offsets[i] = cast(uint16_t, table_size);
+            table_size += size;
+        }
+    }
+
+    Fb_Pad(fb, 2);
+    size_t vtable_pos = fb->b.size;
+    Fb_Scalar(fb, 4 + 2 * num_fields, 2);
+    Fb_Scalar(fb, table_size, 2);
+    int i;
+    for (i = 0; i != num_fields; ++i)
+        Fb_Scalar(fb, fields[i].size == 0 ? 0 : offsets[i], 2);
+
+    Fb_Pad(fb, 8);
+    size_t table_pos = fb->b.size;
+    Fb_Scalar(fb, table_pos - vtable_pos, 4);
+    Fb_Pad(fb, 1);
+
+    size_t at = 4;
+    while (at != table_size) {  // zero fill, fields are written below
+        Fb_Scalar(fb, 0, 1);
+        ++at;
+    }
+
+    for (i = 0; i != num_fields; ++i) {
+        if (fields[i].size == 0)
+            continue;
+        pos[i] = table_pos + offsets[i];
+        if (fb->ok)
+            Put_Little_Endian(
+                fb->b.data + pos[i], fields[i].value, fields[i].size
+            );
+    }
+    return table_pos;
+}
+
+// Returns position of the vector (its length), elements start 4 bytes after.
+//
+static size_t Fb_Vector(
+    FlatBuilder* fb,
+    size_t count,
+    size_t element_size
+){
+    Fb_Pad(fb, 4);
+    if (element_size == 8 or element_size == 16) {
+        if ((fb->b.size + 4) % 8 != 0)
+            Fb_Scalar(fb, 0, 4);
+    }
+    size_t vector_pos = fb->b.size;
+    Fb_Scalar(fb, count, 4);
+    size_t i;
+    for (i = 0; i != count * element_size; ++i)
+        Fb_Scalar(fb, 0, 1);
+    return vector_pos;
+}
+
+static size_t Fb_String(FlatBuilder* fb, const void* utf8, size_t size) {
+    Fb_Pad(fb, 4);
+    size_t string_pos = fb->b.size;
+    Fb_Scalar(fb, size, 4);
+    Fb_Raw(fb, utf8, size);
+    Fb_Scalar(fb, 0, 1);  // strings are also NUL terminated
+    return string_pos;
+}
+
+
+//=//// ARROW COLUMN BUILDING /////////////////////////////////////////////=//
+//
+// Values are converted from what Describe_ODBC_Results() chose to fetch:
+// integers keep their width and signedness, DATE is days since 1970-01-01,
+// TIME is seconds since midnight, and TIMESTAMP is microseconds since 1970
+// (no time zone).  CHAR and WCHAR text are both UTF-8 in Arrow.
+
+struct ArrowColumnStruct {
+    ArrowTypeId type;
+    int bit_width;  // for Int
+    bool is_signed;  // for Int
+    size_t value_size;  // 0 for variable sized or bit-packed types
+
+    ByteBuffer validity;  // bitmap, bit set if not NULL
+    ByteBuffer values;  // fixed size values, bitmap for Bool, or offsets
+    ByteBuffer data;  // text or binary data for Utf8 and Binary
+    SQLLEN null_count;
+};
+typedef struct ArrowColumnStruct ArrowColumn;
+
+static void Init_Arrow_Column(ArrowColumn* ac, const Column* col) {
+    ac->is_signed = false;
+    ac->bit_width = 0;
+    ac->value_size = 0;
+
+    switch (col->c_type) {
+      case SQL_C_BIT:
+        ac->type = ARROW_BOOL;
+        break;
+
+      case SQL_C_UTINYINT:
+        ac->type = ARROW_INT;
+        ac->value_size = 1;
+        break;
+
+      case SQL_C_SLONG:
+      case SQL_C_ULONG:
+        ac->type = ARROW_INT;
+        ac->value_size = 4;
+        ac->is_signed = (col->c_type == SQL_C_SLONG);
+        break;
+
+      case SQL_C_SBIGINT:
+      case SQL_C_UBIGINT:
+        ac->type = ARROW_INT;
+        ac->value_size = 8;
+        ac->is_signed = (col->c_type == SQL_C_SBIGINT);
+        break;
+
+      case SQL_C_DOUBLE:
+        ac->type = ARROW_FLOATING_POINT;
+        ac->value_size = 8;
+        break;
+
+      case SQL_C_TYPE_DATE:
+        ac->type = ARROW_DATE;
+        ac->value_size = 4;
+        break;
+
+      case SQL_C_TYPE_TIME:
+        ac->type = ARROW_TIME;
+        ac->value_size = 4;
+        break;
+
+      case SQL_C_TYPE_TIMESTAMP:
+        ac->type = ARROW_TIMESTAMP;
+        ac->value_size = 8;
+        break;
+
+      case SQL_C_BINARY:
+        ac->type = ARROW_BINARY;
+        break;
+
+      default:
+        assert(col->c_type == SQL_C_CHAR or col->c_type == SQL_C_WCHAR);
+        ac->type = ARROW_UTF8;
+        break;
+    }
+    ac->bit_width = cast(int, ac->value_size * 8);
+
+    ac->validity.data = ac->values.data = ac->data.data = nullptr;
+    ac->validity.capacity = ac->values.capacity = ac->data.capacity = 0;
+    ac->validity.size = ac->values.size = ac->data.size = 0;
+    ac->null_count = 0;
+}
+
+static void Free_Arrow_Column(ArrowColumn* ac) {
+    Free_Byte_Buffer(&ac->validity);
+    Free_Byte_Buffer(&ac->values);
+    Free_Byte_Buffer(&ac->data);
+}
+
+static bool Append_Bit(ByteBuffer* b, SQLLEN index, bool on) {
+    if (index % 8 == 0) {
+        unsigned char zero = 0;
+        if (not Append_Bytes(b, &zero, 1))
+            return false;
+    }
+    if (on)
+        b->data[index / 8] |= cast(unsigned char, 1 << (index % 8));
+    return true;
+}
+
+// https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+//
+static int32_t Days_From_Civil(int year, unsigned month, unsigned day) {
+    year -= (month <= 2);
+    int era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yoe = cast(unsigned, year - era * 400);
+    unsigned mp = (month > 2 ? month - 3 : month + 9);
+    unsigned doy = (153 * mp + 2) / 5 + day - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + cast(int32_t, doe) - 719468;
+}
+
+static bool Append_Arrow_Cell(
+    ArrowColumn* ac,
+    const Column* col,
+    SQLLEN row,  // within the batch
+    const void* buffer,
+    SQLLEN len
+){
+    bool is_null = (len == SQL_NULL_DATA);
+    if (is_null)
+        ++ac->null_count;
+    if (not Append_Bit(&ac->validity, row, not is_null))
+        return false;
+
+    if (ac->type == ARROW_BOOL)
+        return Append_Bit(
+            &ac->values, row,
+            not is_null and *cast(const unsigned char*, buffer) != 0
+        );
+
+    if (ac->value_size == 0) {  // Utf8 or Binary, offsets are int32
+        if (row == 0 and not Append_Bytes(&ac->values, "\0\0\0\0", 4))
+            return false;
+
+        if (not is_null) {
+            if (ac->type == ARROW_BINARY) {
+                if (not Append_Bytes(&ac->data, buffer, len))
+                    return false;
+            }
+            else if (not Append_Cell_As_UTF8(&ac->data, col, buffer, len))
+                return false;
+        }
+        if (ac->data.size > INT32_MAX)
+            return false;  // caller suggests a smaller :BATCH
+
+        int32_t offset = cast(int32_t, ac->data.size);
+        return Append_Bytes(&ac->values, &offset, 4);
+    }
+
+    unsigned char value[8] = {0, 0, 0, 0, 0, 0, 0, 0};  // zeros for NULL
+    if (not is_null) {
+        switch (col->c_type) {
+          case SQL_C_TYPE_DATE: {
+            const DATE_STRUCT* date = cast(const DATE_STRUCT*, buffer);
+            int32_t days = Days_From_Civil(date->year, date->month, date->day);
+            memcpy(value, &days, 4);
+            break; }
+
+          case SQL_C_TYPE_TIME: {
+            const TIME_STRUCT* time = cast(const TIME_STRUCT*, buffer);
+            int32_t seconds = (
+                time->hour * 3600 + time->minute * 60 + time->second
+            );
+            memcpy(value, &seconds, 4);
+            break; }
+
+          case SQL_C_TYPE_TIMESTAMP: {
+            const TIMESTAMP_STRUCT* stamp = cast(
+                const TIMESTAMP_STRUCT*, buffer
+            );
+            int64_t seconds = (
+                cast(int64_t, Days_From_Civil(
+                    stamp->year, stamp->month, stamp->day
+                )) * 86400
+                + stamp->hour * 3600 + stamp->minute * 60 + stamp->second
+            );
+            int64_t micros = seconds * 1000000 + stamp->fraction / 1000;
+            memcpy(value, &micros, 8);
+            break; }
+
+          default:  // integers and doubles are already the right layout
+            memcpy(value, buffer, ac->value_size);
+            break;
+        }
+    }
+    return Append_Bytes(&ac->values, value, ac->value_size);
+}
+
+
+//=//// ARROW MESSAGES ////////////////////////////////////////////////////=//
+//
+// 1. Column values are copied in the machine's byte order, and the Schema
+//    says which that is.  The FlatBuffer metadata is always little endian.
+//
+// 2. Arrow requires a children vector even for types that have none.
+//
+// 3. The validity bitmap may be left empty if there are no NULLs.
+
+struct ArrowWriterStruct {
+    FILE* file;  // nullptr if building a BLOB! in `out`
+    ByteBuffer out;
+    FlatBuilder fb;
+    ByteBuffer body;
+    const char* failure;
+};
+typedef struct ArrowWriterStruct ArrowWriter;
+
+static bool Arrow_Write_Message(ArrowWriter* w) {
+    if (not w->fb.ok) {
+        w->failure = "Out of memory in EXPORT-ARROW-ODBC";
+        return false;
+    }
+    Fb_Pad(&w->fb, 8);  // so the body starts 8-byte aligned
+
+    unsigned char prefix[8];
+    Put_Little_Endian(prefix, 0xFFFFFFFF, 4);  // continuation marker
+    Put_Little_Endian(prefix + 4, w->fb.b.size, 4);
+    if (
+        not Append_Bytes(&w->out, prefix, 8)
+        or not Append_Bytes(&w->out, w->fb.b.data, w->fb.b.size)
+        or not Append_Bytes(&w->out, w->body.data, w->body.size)
+    ){
+        w->failure = "Out of memory in EXPORT-ARROW-ODBC";
+        return false;
+    }
+
+    if (w->file) {
+        if (fwrite(w->out.data, 1, w->out.size, w->file) != w->out.size) {
+            w->failure = "Error writing EXPORT-ARROW-ODBC file";
+            return false;
+        }
+        w->out.size = 0;
+    }
+    return true;
+}
+
+// Start a Message table, and return where to put the header's offset.
+//
+static size_t Arrow_Begin_Message(
+    ArrowWriter* w,
+    unsigned char header_type,
+    size_t body_length
+){
+    w->fb.b.size = 0;
+    w->fb.ok = true;
+
+    Fb_Scalar(&w->fb, 0, 4);  // root table offset
+
+    FbField message[4];
+    message[0].size = 2;  // version
+    message[0].value = 4;  // MetadataVersion.V5
+    message[1].size = 1;  // header_type
+    message[1].value = header_type;
+    message[2].size = 4;  // header
+    message[2].value = 0;
+    message[3].size = 8;  // bodyLength
+    message[3].value = body_length;
+
+    size_t pos[4];
+    size_t message_pos = Fb_Table(&w->fb, message, 4, pos);
+    Fb_Offset(&w->fb, 0, message_pos);
+    return pos[2];
+}
+
+static size_t Arrow_Type_Table(FlatBuilder* fb, const ArrowColumn* ac) {
+    FbField fields[2];
+    size_t pos[2];
+    int num_fields = 0;
+
+    switch (ac->type) {
+      case ARROW_INT:
+        fields[0].size = 4;  // bitWidth
+        fields[0].value = ac->bit_width;
+        fields[1].size = 1;  // is_signed
+        fields[1].value = ac->is_signed ? 1 : 0;
+        num_fields = 2;
+        break;
+
+      case ARROW_FLOATING_POINT:
+        fields[0].size = 2;  // precision
+        fields[0].value = 2;  // Precision.DOUBLE
+        num_fields = 1;
+        break;
+
+      case ARROW_DATE:
+        fields[0].size = 2;  // unit
+        fields[0].value = 0;  // DateUnit.DAY
+        num_fields = 1;
+        break;
+
+      case ARROW_TIME:
+        fields[0].size = 2;  // unit
+        fields[0].value = 0;  // TimeUnit.SECOND
+        fields[1].size = 4;  // bitWidth
+        fields[1].value = 32;
+        num_fields = 2;
+        break;
+
+      case ARROW_TIMESTAMP:
+        fields[0].size = 2;  // unit
+        fields[0].value = 2;  // TimeUnit.MICROSECOND
+        num_fields = 1;
+        break;
+
+      default:  // Utf8, Binary, and Bool tables have no fields
+        break;
+    }
+    return Fb_Table(fb, fields, num_fields, pos);
+}
+
+static bool Arrow_Write_Schema(
+    ArrowWriter* w,
+    const Column* columns,
+    const ArrowColumn* arrow,
+    SQLSMALLINT num_columns
+){
+    FlatBuilder* fb = &w->fb;
+    size_t header_field = Arrow_Begin_Message(w, 1, 0);  // Schema
+
+    uint16_t probe = 1;
+    bool big_endian = (*cast(unsigned char*, &probe) == 0);  // see [1]
+
+    FbField schema[2];
+    schema[0].size = 2;  // endianness
+    schema[0].value = big_endian ? 1 : 0;
+    schema[1].size = 4;  // fields
+    schema[1].value = 0;
+
+    size_t schema_pos[2];
+    size_t schema_table = Fb_Table(fb, schema, 2, schema_pos);
+    Fb_Offset(fb, header_field, schema_table);
+
+    size_t vector = Fb_Vector(fb, num_columns, 4);
+    Fb_Offset(fb, schema_pos[1], vector);
+
+    SQLSMALLINT n;
+    for (n = 0; n != num_columns; ++n) {
+        FbField field[6];
+        field[0].size = 4;  // name
+        field[0].value = 0;
+        field[1].size = 1;  // nullable
+        field[1].value = (columns[n].nullable != SQL_NO_NULLS) ? 1 : 0;
+        field[2].size = 1;  // type_type
+        field[2].value = arrow[n].type;
+        field[3].size = 4;  // type
+        field[3].value = 0;
+        field[4].size = 0;  // dictionary
+        field[5].size = 4;  // children, see [2]
+        field[5].value = 0;
+
+        size_t pos[6];
+        size_t field_table = Fb_Table(fb, field, 6, pos);
+        Fb_Offset(fb, vector + 4 + 4 * n, field_table);
+
+        size_t size;
+        unsigned char* name = rebBytes(&size, columns[n].title);
+        size_t name_pos = Fb_String(fb, name, size);
+        rebFree(name);
+        Fb_Offset(fb, pos[0], name_pos);
+
+        Fb_Offset(fb, pos[3], Arrow_Type_Table(fb, &arrow[n]));
+        Fb_Offset(fb, pos[5], Fb_Vector(fb, 0, 4));
+    }
+
+    w->body.size = 0;
+    return Arrow_Write_Message(w);
+}
+
+static bool Arrow_Add_Buffer(
+    ArrowWriter* w,
+    size_t buffers_vector,
+    int* buffer_index,
+    const ByteBuffer* b
+){
+    static const unsigned char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    size_t offset = w->body.size;
+    size_t size = b ? b->size : 0;
+    if (
+        (size != 0 and not Append_Bytes(&w->body, b->data, size))
+        or not Append_Bytes(&w->body, zeros, (8 - size % 8) % 8)
+    ){
+        return false;
+    }
+
+    if (w->fb.ok) {
+        unsigned char* element = (
+            w->fb.b.data + buffers_vector + 4 + 16 * (*buffer_index)
+        );
+        Put_Little_Endian(element, offset, 8);
+        Put_Little_Endian(element + 8, size, 8);
+    }
+    ++(*buffer_index);
+    return true;
+}
+
+static bool Arrow_Write_Record_Batch(
+    ArrowWriter* w,
+    const ArrowColumn* arrow,
+    SQLSMALLINT num_columns,
+    SQLLEN num_rows
+){
+    FlatBuilder* fb = &w->fb;
+
+    size_t num_buffers = 0;
+    SQLSMALLINT n;
+    for (n = 0; n != num_columns; ++n)
+        num_buffers += (
+            arrow[n].value_size == 0 and arrow[n].type != ARROW_BOOL
+        ) ? 3 : 2;
+
+    w->body.size = 0;
+
+    // The body length goes in the Message table, which is written before
+    // the buffers.  So size up the body first.
+    //
+    size_t body_length = 0;
+    for (n = 0; n != num_columns; ++n) {
+        const ArrowColumn* ac = &arrow[n];
+        if (ac->null_count != 0)
+            body_length += (ac->validity.size + 7) / 8 * 8;
+        body_length += (ac->values.size + 7) / 8 * 8;
+        body_length += (ac->data.size + 7) / 8 * 8;
+    }
+
+    size_t header_field = Arrow_Begin_Message(w, 3, body_length);  // batch
+
+    FbField batch[3];
+    batch[0].size = 8;  // length
+    batch[0].value = num_rows;
+    batch[1].size = 4;  // nodes
+    batch[1].value = 0;
+    batch[2].size = 4;  // buffers
+    batch[2].value = 0;
+
+    size_t pos[3];
+    size_t batch_table = Fb_Table(fb, batch, 3, pos);
+    Fb_Offset(fb, header_field, batch_table);
+
+    size_t nodes = Fb_Vector(fb, num_columns, 16);
+    Fb_Offset(fb, pos[1], nodes);
+    for (n = 0; n != num_columns; ++n) {
+        if (not fb->ok)
+            break;
+        unsigned char* node = fb->b.data + nodes + 4 + 16 * n;
+        Put_Little_Endian(node, num_rows, 8);
+        Put_Little_Endian(node + 8, arrow[n].null_count, 8);
+    }
+
+    size_t buffers = Fb_Vector(fb, num_buffers, 16);
+    Fb_Offset(fb, pos[2], buffers);
+
+    int index = 0;
+    bool ok = true;
+    for (n = 0; ok and n != num_columns; ++n) {
+        const ArrowColumn* ac = &arrow[n];
+        ok = Arrow_Add_Buffer(  // see [3]
+            w, buffers, &index, ac->null_count == 0 ? nullptr : &ac->validity
+        );
+        ok = ok and Arrow_Add_Buffer(w, buffers, &index, &ac->values);
+        if (ac->value_size == 0 and ac->type != ARROW_BOOL)
+            ok = ok and Arrow_Add_Buffer(w, buffers, &index, &ac->data);
+    }
+    if (not ok) {
+        w->failure = "Out of memory in EXPORT-ARROW-ODBC";
+        return false;
+    }
+    assert(w->body.size == body_length);
+
+    return Arrow_Write_Message(w);
+}
+
+
+// Column-wise arrays for fetching with SQLBindCol(), if all columns have a
+// fixed size.
+//
+struct ArrowBindingStruct {
+    unsigned char** values;
+    SQLLEN** lengths;
+    SQLULEN array_rows;
+    SQLULEN rows_fetched;
+};
+typedef struct ArrowBindingStruct ArrowBinding;
+
+// Fetches the rest of the rows and writes the record batches.  Returns false
+// with w->failure set for non-ODBC problems, or with it null if the error is
+// in the HSTMT's diagnostics.
+//
+static bool Arrow_Write_Rows(
+    ArrowWriter* w,
+    SQLHSTMT hstmt,
+    const Column* columns,
+    ArrowColumn* arrow,
+    SQLSMALLINT num_columns,
+    Option(ArrowBinding*) binding,
+    SQLLEN batch_rows,
+    SQLLEN* total_rows
+){
+    RowBlock block;
+    Init_Row_Block(&block, num_columns);
+
+    bool ok = true;
+    bool done = false;
+    SQLSMALLINT n;
+
+    while (ok and not done) {
+        for (n = 0; n != num_columns; ++n) {
+            Free_Arrow_Column(&arrow[n]);
+            Init_Arrow_Column(&arrow[n], &columns[n]);
+        }
+
+        SQLLEN rows = 0;
+        while (ok and not done and rows < batch_rows) {  // arrays overshoot
+            if (binding) {
+                ArrowBinding* b = unwrap binding;
+                SQLRETURN rc = SQLFetch(hstmt);
+                if (rc == SQL_NO_DATA) {
+                    done = true;
+                    break;
+                }
+                if (not SQL_SUCCEEDED(rc)) {
+                    ok = false;
+                    break;
+                }
+
+                SQLULEN r;
+                for (r = 0; ok and r != b->rows_fetched; ++r, ++rows) {
+                    for (n = 0; ok and n != num_columns; ++n)
+                        ok = Append_Arrow_Cell(
+                            &arrow[n], &columns[n], rows,
+                            b->values[n] + r * columns[n].buffer_size,
+                            b->lengths[n][r]
+                        );
+                }
+            }
+            else {
+                Fetch_Rows_Raw(hstmt, columns, &block, batch_rows - rows);
+                if (block.failure) {
+                    w->failure = block.failure;
+                    ok = false;
+                    break;
+                }
+                if (block.rc != SQL_SUCCESS and block.rc != SQL_NO_DATA) {
+                    ok = false;
+                    break;
+                }
+                done = (block.rc == SQL_NO_DATA);
+
+                size_t cell = 0;
+                SQLLEN r;
+                for (r = 0; ok and r != block.num_rows; ++r, ++rows) {
+                    for (n = 0; ok and n != num_columns; ++n, ++cell)
+                        ok = Append_Arrow_Cell(
+                            &arrow[n], &columns[n], rows,
+                            block.bytes.data + block.offsets[cell],
+                            block.lengths[cell]
+                        );
+                }
+            }
+            if (not ok and not w->failure)
+                w->failure = (
+                    "Out of memory in EXPORT-ARROW-ODBC (or a batch had"
+                    " over 2GB of text, try a smaller :BATCH)"
+                );
+        }
+
+        if (ok and rows != 0) {
+            ok = Arrow_Write_Record_Batch(w, arrow, num_columns, rows);
+            *total_rows += rows;
+        }
+    }
+
+    Free_Row_Block(&block);
+    return ok;
+}
+
+
+//
+//  export /export-arrow-odbc: native [
+//
+//  "Write the rest of a result set as an Apache Arrow IPC stream"
+//
+//      return: "Stream as BLOB!, or number of rows if written to a file"
+//          [blob! integer!]
+//      statement [object!]
+//      :file "Write the stream to a file instead of returning it"
+//          [file!]
+//      :batch "Rows per record batch, default is 65536"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(EXPORT_ARROW_ODBC)
+//
+// 1. If every column has a fixed size, rows are fetched many at a time into
+//    column-wise arrays with SQLBindCol() and SQL_ATTR_ROW_ARRAY_SIZE.  The
+//    driver may lower the array size it was asked for, so read it back.
+//    Variable sized columns need the SQLGetData() loop of Fetch_Rows_Raw().
+{
+    INCLUDE_PARAMS_OF_EXPORT_ARROW_ODBC;
+
+    Finish_Prefetch();  // no worker thread may be using a handle
+
+    SQLHSTMT hstmt = rebUnboxHandle(SQLHSTMT,
+        "ensure handle! statement.hstmt"
+    );
+    ColumnList* list = rebUnboxHandle(ColumnList*,
+        "ensure handle! statement.columns"
+    );
+    if (hstmt == SQL_NULL_HANDLE or not list->columns)
+        return "panic -[Invalid statement object!]-";
+
+    SQLLEN batch_rows = rebUnboxInteger(
+        "any [batch,", rebI(ARROW_DEFAULT_BATCH_ROWS), "]"
+    );
+    if (batch_rows < 1)
+        return "panic -[EXPORT-ARROW-ODBC :BATCH must be at least 1]-";
+
+    SQLSMALLINT num_columns = list->num_columns;
+    const Column* columns = list->columns;
+
+    ArrowWriter w;
+    w.file = nullptr;
+    w.out.data = w.fb.b.data = w.body.data = nullptr;
+    w.out.size = w.fb.b.size = w.body.size = 0;
+    w.out.capacity = w.fb.b.capacity = w.body.capacity = 0;
+    w.fb.ok = true;
+    w.failure = nullptr;
+
+    if (rebUnboxLogic("did file")) {
+      #if TO_WINDOWS
+        SQLWCHAR* path = rebSpellWide("file-to-local:full file");
+        w.file = _wfopen(cast(wchar_t*, path), L"wb");
+      #else
+        char* path = rebSpell("file-to-local:full file");
+        w.file = fopen(path, "wb");
+      #endif
+        rebFree(path);
+        if (w.file == nullptr)
+            return rebDelegate(
+                "panic [-[EXPORT-ARROW-ODBC could not open]- file]"
+            );
+    }
+
+    ArrowColumn* arrow = rebAllocN(ArrowColumn, num_columns);
+
+    ArrowBinding b;
+    b.values = rebAllocN(unsigned char*, num_columns);
+    b.lengths = rebAllocN(SQLLEN*, num_columns);
+    b.array_rows = 1;
+    b.rows_fetched = 0;
+
+    bool use_binding = true;  // see [1]
+    SQLSMALLINT n;
+    for (n = 0; n != num_columns; ++n) {
+        Init_Arrow_Column(&arrow[n], &columns[n]);
+        if (arrow[n].value_size == 0 and arrow[n].type != ARROW_BOOL)
+            use_binding = false;
+        b.values[n] = nullptr;
+        b.lengths[n] = nullptr;
+    }
+
+    bool ok = true;
+    SQLLEN total_rows = 0;
+
+    if (use_binding) {
+        b.array_rows = batch_rows < ARROW_BIND_ARRAY_ROWS
+            ? batch_rows
+            : ARROW_BIND_ARRAY_ROWS;
+
+        SQLSetStmtAttr(
+            hstmt, SQL_ATTR_ROW_BIND_TYPE,
+            p_cast(SQLPOINTER, cast(uintptr_t, SQL_BIND_BY_COLUMN)), 0
+        );
+        SQLSetStmtAttr(
+            hstmt, SQL_ATTR_ROW_ARRAY_SIZE,
+            p_cast(SQLPOINTER, cast(uintptr_t, b.array_rows)), 0
+        );
+        if (not SQL_SUCCEEDED(SQLGetStmtAttr(
+            hstmt, SQL_ATTR_ROW_ARRAY_SIZE, &b.array_rows, 0, nullptr
+        ))){
+            b.array_rows = 1;
+        }
+        SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &b.rows_fetched, 0);
+
+        for (n = 0; ok and n != num_columns; ++n) {
+            b.values[n] = cast(unsigned char*,
+                malloc(b.array_rows * columns[n].buffer_size)
+            );
+            b.lengths[n] = cast(SQLLEN*,
+                malloc(b.array_rows * sizeof(SQLLEN))
+            );
+            if (b.values[n] == nullptr or b.lengths[n] == nullptr) {
+                w.failure = "Out of memory in EXPORT-ARROW-ODBC";
+                ok = false;
+                break;
+            }
+            ok = SQL_SUCCEEDED(SQLBindCol(
+                hstmt,
+                n + 1,
+                columns[n].c_type,
+                b.values[n],
+                columns[n].buffer_size,
+                b.lengths[n]
+            ));
+        }
+    }
+
+    ok = ok and Arrow_Write_Schema(&w, columns, arrow, num_columns);
+    ok = ok and Arrow_Write_Rows(
+        &w, hstmt, columns, arrow, num_columns,
+        use_binding ? &b : nullptr, batch_rows, &total_rows
+    );
+
+    if (ok) {  // end of stream marker
+        unsigned char eos[8];
+        Put_Little_Endian(eos, 0xFFFFFFFF, 4);
+        Put_Little_Endian(eos + 4, 0, 4);
+        if (not Append_Bytes(&w.out, eos, 8)) {
+            w.failure = "Out of memory in EXPORT-ARROW-ODBC";
+            ok = false;
+        }
+        else if (
+            w.file
+            and fwrite(w.out.data, 1, w.out.size, w.file) != w.out.size
+        ){
+            w.failure = "Error writing EXPORT-ARROW-ODBC file";
+            ok = false;
+        }
+    }
+
+    Value* error = nullptr;
+    if (w.failure)
+        error = rebValue("make error!", rebT(w.failure));
+    else if (not ok)
+        error = Error_ODBC_Stmt(hstmt);  // before SQLFreeStmt() clears it
+
+    if (use_binding) {
+        SQLFreeStmt(hstmt, SQL_UNBIND);
+        SQLSetStmtAttr(
+            hstmt, SQL_ATTR_ROW_ARRAY_SIZE,
+            p_cast(SQLPOINTER, cast(uintptr_t, 1)), 0
+        );
+        SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+    }
+
+    for (n = 0; n != num_columns; ++n) {
+        Free_Arrow_Column(&arrow[n]);
+        free(b.values[n]);
+        free(b.lengths[n]);
+    }
+    rebFree(arrow);
+    rebFree(b.values);
+    rebFree(b.lengths);
+    Free_Byte_Buffer(&w.fb.b);
+    Free_Byte_Buffer(&w.body);
+
+    if (w.file and fclose(w.file) != 0 and not error)
+        error = rebValue(
+            "make error! -[Error closing EXPORT-ARROW-ODBC file]-"
+        );
+
+    Value* result = nullptr;
+    if (not error) {
+        if (w.file)
+            result = rebInteger(total_rows);
+        else
+            result = rebSizedBlob(w.out.data, w.out.size);
+    }
+    Free_Byte_Buffer(&w.out);
+
+    if (error)
+        return rebDelegate("panic", rebR(error));
+    return result;
+}
+
+
+static SQLRETURN Set_Autocommit(SQLHDBC hdbc, bool on) {
+    return SQLSetConnectAttr(
+        hdbc,
+        SQL_ATTR_AUTOCOMMIT,
+        p_cast(
+            SQLPOINTER*,
+            i_cast(uintptr_t, on ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF)
+        ),
+        SQL_IS_UINTEGER
+    );
+}
+
+
+//
+//  export /update-odbc: native [
+//
+//      return: [trash!]
+//      connection [object!]
+//      access [logic!]
+//      commit [logic!]
+//  ]
+//
+DECLARE_NATIVE(UPDATE_ODBC)
+{
+    INCLUDE_PARAMS_OF_UPDATE_ODBC;
+
+    // Get connection handle
+    //
+    SQLHDBC hdbc = rebUnboxHandle(SQLHDBC, "ensure handle! connection.hdbc");
+
+    SQLRETURN rc;
+
+    bool access = rebUnboxLogic("access");
+    rc = SQLSetConnectAttr(
+        hdbc,
+        SQL_ATTR_ACCESS_MODE,
+        p_cast(
+            SQLPOINTER*,
+            i_cast(uintptr_t,
+                access ? SQL_MODE_READ_WRITE : SQL_MODE_READ_ONLY
+            )
+        ),
+        SQL_IS_UINTEGER
+    );
+
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Dbc(hdbc));
+
+    bool commit = rebUnboxLogic("commit");
+    rc = Set_Autocommit(hdbc, commit);
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Dbc(hdbc));
+
+    return "~<?>~";
+}
+
+
+//
+//  export /begin-odbc: native [
+//
+//  "Start a transaction by turning off autocommit on the connection"
+//
+//      return: [trash!]
+//      connection [object!]
+//      :batch "Commit automatically after every N statements executed"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(BEGIN_ODBC)
+//
+// ODBC has no "BEGIN TRANSACTION" call: when autocommit is off, a transaction
+// is implicitly started by the first statement and ended by SQLEndTran().
+// So beginning is just a matter of switching autocommit off, and remembering
+// what it was so COMMIT-ODBC or ROLLBACK-ODBC can put it back.
+{
+    INCLUDE_PARAMS_OF_BEGIN_ODBC;
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! connection.hdbc"
+    );
+
+    if (conn->in_transaction)
+        return "panic -[BEGIN-ODBC called while already in a transaction]-";
+
+    SQLLEN batch_size = rebUnbox("any [batch, 0]");
+    if (batch_size < 0)
+        return "panic -[BEGIN-ODBC:BATCH size must not be negative]-";
+
+    SQLUINTEGER autocommit;
+    SQLRETURN rc = SQLGetConnectAttr(
+        conn->hdbc,
+        SQL_ATTR_AUTOCOMMIT,
+        &autocommit,
+        SQL_IS_UINTEGER,
+        nullptr  // StringLengthPtr (not a string attribute)
+    );
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Dbc(conn->hdbc));
+
+    if (autocommit == SQL_AUTOCOMMIT_ON) {
+        rc = Set_Autocommit(conn->hdbc, false);
+        if (not SQL_SUCCEEDED(rc))
+            return rebDelegate("panic", Error_ODBC_Dbc(conn->hdbc));
+    }
+
+    conn->in_transaction = true;
+    conn->autocommit_was_on = (autocommit == SQL_AUTOCOMMIT_ON);
+    conn->batch_size = batch_size;
+    conn->batch_count = 0;
+    if (batch_size != 0)
+        ++g_num_batching_connections;
+
+    return "~<?>~";
+}
+
+
+// COMMIT-ODBC and ROLLBACK-ODBC are the same apart from the SQLEndTran()
+// completion type, so they share this implementation.
+//
+// 1. A failed SQLEndTran() still ends the BEGIN-ODBC (unless :CHAIN), so the
+//    connection isn't left with autocommit off and `in_transaction` set.  The
+//    error is made first, as later calls replace the diagnostic records.
+//
+// 2. Turning autocommit back on commits whatever is pending, so after a
+//    failed COMMIT the transaction is rolled back first.
+//
+// 3. ODBC-EXECUTE:CACHE results may hold rows that a rollback undid, and
+//    there's no telling which tables were changed, so they're all dropped.
+//
+static void End_Transaction(
+    Connection* conn,
+    SQLSMALLINT completion,  // SQL_COMMIT or SQL_ROLLBACK
+    bool chain
+){
+    Value* error = nullptr;
+
+    SQLRETURN rc = SQLEndTran(SQL_HANDLE_DBC, conn->hdbc, completion);
+    if (not SQL_SUCCEEDED(rc))
+        error = Error_ODBC_Dbc(conn->hdbc);  // see [1]
+
+    bool rolled_back = (completion == SQL_ROLLBACK);
+
+    conn->batch_count = 0;
+
+    if (not chain and conn->in_transaction) {
+        conn->in_transaction = false;
+        if (conn->batch_size != 0) {
+            conn->batch_size = 0;
+            --g_num_batching_connections;
+        }
+
+        if (conn->autocommit_was_on) {
+            if (error and completion == SQL_COMMIT) {  // see [2]
+                SQLEndTran(SQL_HANDLE_DBC, conn->hdbc, SQL_ROLLBACK);
+                rolled_back = true;
+            }
+
+            rc = Set_Autocommit(conn->hdbc, true);
+            if (not SQL_SUCCEEDED(rc) and not error)
+                error = Error_ODBC_Dbc(conn->hdbc);
+        }
+    }
+
+    if (rolled_back)
+        rebElide("clear-result-cache");  // see [3]
+
+    if (error)
+        rebJumps ("panic", rebR(error));
+}
+
+
+//
+//  export /commit-odbc: native [
+//
+//  "Commit the connection's transaction (restores autocommit unless :CHAIN)"
+//
+//      return: [trash!]
+//      connection [object!]
+//      :chain "Stay in the transaction, next statement starts a new one"
+//  ]
+//
+DECLARE_NATIVE(COMMIT_ODBC)
+{
+    INCLUDE_PARAMS_OF_COMMIT_ODBC;
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! connection.hdbc"
+    );
+
+    End_Transaction(conn, SQL_COMMIT, rebUnboxLogic("chain"));
+    return "~<?>~";
+}
+
+
+//
+//  export /rollback-odbc: native [
+//
+//  "Roll back connection's transaction (restores autocommit unless :CHAIN)"
+//
+//      return: [trash!]
+//      connection [object!]
+//      :chain "Stay in the transaction, next statement starts a new one"
+//  ]
+//
+DECLARE_NATIVE(ROLLBACK_ODBC)
+{
+    INCLUDE_PARAMS_OF_ROLLBACK_ODBC;
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! connection.hdbc"
+    );
+
+    End_Transaction(conn, SQL_ROLLBACK, rebUnboxLogic("chain"));
+    return "~<?>~";
+}
+
+
+//
+//  export /info-odbc: native [
+//
+//  "Get information about the driver and DBMS of a connection"
+//
+//      return: [text! integer!]
+//      connection [object!]
+//      which "Note MAX-STATEMENT-LENGTH is 0 if there's no fixed limit"
+//          [~[dbms-name dbms-version driver-name max-statement-length]~]
+//  ]
+//
+DECLARE_NATIVE(INFO_ODBC)
+{
+    INCLUDE_PARAMS_OF_INFO_ODBC;
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! connection.hdbc"
+    );
+
+    SQLRETURN rc;
+
+    if (rebUnboxLogic("'max-statement-length = which")) {
+        SQLUINTEGER length;
+        rc = SQLGetInfoW(
+            conn->hdbc, SQL_MAX_STATEMENT_LEN, &length, sizeof(length), nullptr
+        );
+        if (not SQL_SUCCEEDED(rc))
+            return rebDelegate("panic", Error_ODBC_Dbc(conn->hdbc));
+        return rebInteger(length);
+    }
+
+    SQLUSMALLINT info_type = rebUnboxInteger(
+        "switch which [",
+            "'dbms-name [", rebI(SQL_DBMS_NAME), "]",
+            "'dbms-version [", rebI(SQL_DBMS_VER), "]",
+            "'driver-name [", rebI(SQL_DRIVER_NAME), "]",
+        "]"
+    );
+
+    SQLWCHAR text[256];
+    SQLSMALLINT size;  // in bytes, not including terminator
+    rc = SQLGetInfoW(conn->hdbc, info_type, text, sizeof(text), &size);
+    if (not SQL_SUCCEEDED(rc))
+        return rebDelegate("panic", Error_ODBC_Dbc(conn->hdbc));
+
+    SQLSMALLINT max_size = sizeof(text) - sizeof(SQLWCHAR);
+    return rebLengthedTextWide(
+        text, (size < max_size ? size : max_size) / sizeof(SQLWCHAR)
+    );
+}
+
+
+//
+//  export /pool-odbc: native [
+//
+//  "Get counts for a connection's pool of statement handles"
+//
+//      return: [object!]
+//      connection [object!]
+//      :limit "Keep at most this many idle handles (0 to not pool)"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(POOL_ODBC)
+{
+    INCLUDE_PARAMS_OF_POOL_ODBC;
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! connection.hdbc"
+    );
+
+    if (rebUnboxLogic("did limit")) {
+        int limit = rebUnboxInteger("limit");
+        if (limit < 0 or limit > MAX_IDLE_HSTMTS)
+            return rebDelegate(
+                "panic [-[POOL-ODBC:LIMIT must be from 0 to]-",
+                    rebI(MAX_IDLE_HSTMTS),
+                "]"
+            );
+        conn->max_idle_hstmts = limit;
+
+        while (conn->num_idle_hstmts > limit) {
+            --conn->num_idle_hstmts;
+            SQLFreeHandle(
+                SQL_HANDLE_STMT, conn->idle_hstmts[conn->num_idle_hstmts]
+            );
+            ++conn->num_hstmt_frees;
+        }
+    }
+
+    return rebValue(
+        "make object! [",
+            "limit:", rebI(conn->max_idle_hstmts),
+            "idle:", rebI(conn->num_idle_hstmts),
+            "allocated:", rebI(conn->num_hstmt_allocs),
+            "reused:", rebI(conn->num_hstmt_reuses),
+            "freed:", rebI(conn->num_hstmt_frees),
+        "]"
+    );
+}
+
+
+//
+//  export /capabilities-odbc: native [
+//
+//  "What the connection's driver was found to support, with any overrides"
+//
+//      return: [object!]
+//      connection [object!]
+//      :override "Object spec block, e.g. [any-order: null]"
+//          [block!]
+//  ]
+//
+DECLARE_NATIVE(CAPABILITIES_ODBC)
+//
+// Overrides are for drivers that claim something they don't do well (or at
+// all), or to try something a driver didn't claim.  CHAR-ENCODING overrides
+// ODBC-SET-CHAR-ENCODING for just this connection.  Changes only affect
+// queries that are run after them.
+{
+    INCLUDE_PARAMS_OF_CAPABILITIES_ODBC;
+
+    Connection* conn = rebUnboxHandle(Connection*,
+        "ensure handle! connection.hdbc"
+    );
+    Capabilities* caps = &conn->caps;
+
+    if (rebUnboxLogic("did override")) {
+        Value* o = rebValue("make object! override");
+        rebElide(
+            "for-each 'field words of", o, "[",
+                "if not find [",
+                    "any-order param-arrays fetch-scroll type-names",
+                    "char-encoding",
+                "] field [",
+                    "panic [-[Unknown ODBC capability:]- field]",
+                "]",
+            "]"
+        );
+
+        if (rebUnboxLogic("did has", o, "'any-order"))
+            caps->any_order = rebUnboxLogic(o, ".any-order");
+        if (rebUnboxLogic("did has", o, "'param-arrays"))
+            caps->param_arrays = rebUnboxLogic(o, ".param-arrays");
+        if (rebUnboxLogic("did has", o, "'fetch-scroll"))
+            caps->fetch_scroll = rebUnboxLogic(o, ".fetch-scroll");
+        if (rebUnboxLogic("did has", o, "'type-names"))
+            caps->type_names = rebUnboxLogic(o, ".type-names");
+        if (rebUnboxLogic("did has", o, "'char-encoding")) {
+            caps->has_char_encoding = true;
+            caps->char_encoding = cast(CharColumnEncoding, rebUnboxInteger(
+                "switch", o, ".char-encoding [",
+                    "'utf-8 [", rebI(CHAR_COL_UTF8), "]",
+                    "'utf-16 [", rebI(CHAR_COL_UTF16), "]",
+                    "'latin-1 [", rebI(CHAR_COL_LATIN1), "]",
+                "] else [",
+                    "panic -[CHAR-ENCODING: must be UTF-8, UTF-16, LATIN-1]-",
+                "]"
+            ));
+        }
+
+        rebRelease(o);
+    }
+
+    return rebValue(
+        "make object! [",
+            "any-order:", rebLogic(caps->any_order),
+            "param-arrays:", rebLogic(caps->param_arrays),
+            "fetch-scroll:", rebLogic(caps->fetch_scroll),
+            "type-names:", rebLogic(caps->type_names),
+            "char-encoding: pick [utf-8 utf-16 latin-1]", rebI(
+                Char_Encoding_Of(caps) + 1
+            ),
+        "]"
+    );
+}
+
+
+//
+//  export /handles-odbc: native [
+//
+//  "Counts of the ODBC extension's connection and column list records"
+//
+//      return: [object!]
+//  ]
+//
+DECLARE_NATIVE(HANDLES_ODBC)
+//
+// For watching for leaks in long-running programs.  The `open-` counts are
+// of the records not yet cleaned up by CLOSE-CONNECTION, CLOSE-STATEMENT or
+// a new query.  The others are records still held by a HANDLE! the GC hasn't
+// freed.
+{
+    INCLUDE_PARAMS_OF_HANDLES_ODBC;
+
+    SQLLEN open_connections = 0;
+    SQLLEN idle_statements = 0;
+    Connection* conn = g_all_connections;
+    for (; conn != nullptr; conn = conn->next) {
+        if (conn->hdbc != SQL_NULL_HANDLE)
+            ++open_connections;
+        idle_statements += conn->num_idle_hstmts;
+    }
+
+    SQLLEN open_column_lists = 0;
+    ColumnList* list = g_all_columnlists;
+    for (; list != nullptr; list = list->next) {
+        if (list->columns != nullptr)
+            ++open_column_lists;
     }
 
-    // Note: This happens with BIT(2) and the MySQL ODBC driver, which
-    // reports a sql_type of -2 for some reason.
-    //
-    rebJumps("panic -[Unsupported SQL_XXX type returned from query]-");
+    return rebValue(
+        "make object! [",
+            "connections:", rebI(g_connection_slab.num_live),
+            "open-connections:", rebI(open_connections),
+            "idle-statements:", rebI(idle_statements),
+            "column-lists:", rebI(g_columnlist_slab.num_live),
+            "open-column-lists:", rebI(open_column_lists),
+        "]"
+    );
 }
 
 
 //
-//  export /copy-odbc: native [
+//  export /odbc-set-query-stats: native [
 //
-//  "Block of row blocks for selects and catalog functions"
+//  "Turn on or off the per-query histograms reported by ODBC-QUERY-STATS"
 //
-//      return: [block!]
-//      statement [object!]
-//      :part [integer!]
+//      return: [trash!]
+//      on [logic!]
 //  ]
 //
-DECLARE_NATIVE(COPY_ODBC)
+DECLARE_NATIVE(ODBC_SET_QUERY_STATS)
+//
+// The memory for the stats is freed when they're turned off, so turning them
+// back on starts from nothing.
 {
-    INCLUDE_PARAMS_OF_COPY_ODBC;
+    INCLUDE_PARAMS_OF_ODBC_SET_QUERY_STATS;
 
-    SQLHSTMT hstmt = rebUnboxHandle(SQLHSTMT,
-        "ensure handle! statement.hstmt"
-    );
-
-    ColumnList* list = rebUnboxHandle(ColumnList*,
-        "ensure handle! statement.columns"
-    );
-    Column* columns = list->columns;
-
-    if (hstmt == SQL_NULL_HANDLE or not columns)
-        return "panic -[Invalid statement object!]-";
-
-    SQLRETURN rc;
+    if (rebUnboxLogic("on")) {
+        if (g_query_stats.shapes == nullptr) {
+            g_query_stats.shapes = cast(QueryShape*,
+                malloc(sizeof(QueryShape) * (MAX_QUERY_SHAPES + 1))
+            );
+            if (g_query_stats.shapes == nullptr)
+                return "panic -[Couldn't allocate query stats]-";
+            Reset_Query_Stats();
+        }
+    }
+    else if (g_query_stats.shapes) {
+        free(g_query_stats.shapes);
+        g_query_stats.shapes = nullptr;
+        Reset_Query_Stats();
+    }
 
-    SQLSMALLINT num_columns;
-    rc = SQLNumResultCols(hstmt, &num_columns);
-    if (not SQL_SUCCEEDED(rc))
-        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+    return "~<?>~";
+}
 
-    // compares-0 based row against num_rows, so -1 is chosen to never match
-    // and hence mean "as many rows as available"
-    //
-    SQLLEN num_rows = rebUnbox("any [part, -1]");
 
-    Value* results = rebValue(
-        "make block!", rebI(num_rows == -1 ? 10 : num_rows)
+static Value* Histogram_Object(const Histogram* h) {
+    return rebValue(
+        "make object! [",
+            "count:", rebInteger64(h->count),
+            "total:", rebInteger64(h->total),
+            "p50:", rebInteger64(Histogram_Percentile(h, 50)),
+            "p90:", rebInteger64(Histogram_Percentile(h, 90)),
+            "p99:", rebInteger64(Histogram_Percentile(h, 99)),
+            "max:", rebInteger64(h->max),
+        "]"
     );
+}
 
-    SQLLEN row = 0;
-    for (; row != num_rows; row = (num_rows == -1) ? 0 : row + 1) {
-
-        // This SQLFetch operation "fetches" the next row.  If we were using
-        // column binding, it would be writing data into the memory buffers
-        // we had given it.  But if you use column binding, your buffers have
-        // to be fixed size...and when they're not big enough, you lose the
-        // data.  By avoiding column binding, we can grow our buffers through
-        // multiple successive calls to SQLGetData().
-        //
-        rc = SQLFetch(hstmt);
-
-        switch (rc) {
-          case SQL_SUCCESS:
-            break;  // Row retrieved, and data copied into column buffers
-
-          case SQL_SUCCESS_WITH_INFO: {
-            SQLWCHAR state[6];
-            SQLINTEGER native;
+static bool Append_JSON_Histogram(
+    ByteBuffer* b,
+    const char* name,
+    const Histogram* h
+){
+    return Append_Formatted(b, ",\"%s\":{\"count\":", name)
+        and Append_Formatted(b, "%llu", cast(unsigned long long, h->count))
+        and Append_Formatted(b, ",\"total\":%llu",
+            cast(unsigned long long, h->total))
+        and Append_Formatted(b, ",\"p50\":%llu",
+            cast(unsigned long long, Histogram_Percentile(h, 50)))
+        and Append_Formatted(b, ",\"p90\":%llu",
+            cast(unsigned long long, Histogram_Percentile(h, 90)))
+        and Append_Formatted(b, ",\"p99\":%llu",
+            cast(unsigned long long, Histogram_Percentile(h, 99)))
+        and Append_Formatted(b, ",\"max\":%llu}",
+            cast(unsigned long long, h->max));
+}
 
-            SQLSMALLINT message_len = 0;
+static bool Append_JSON_String(ByteBuffer* b, const char* text) {
+    if (not Append_Bytes(b, "\"", 1))
+        return false;
+    const unsigned char* cp = cast(const unsigned char*, text);
+    for (; *cp != '\0'; ++cp) {
+        bool ok;
+        if (*cp == '"' or *cp == '\\')
+            ok = Append_Bytes(b, "\\", 1) and Append_Bytes(b, cp, 1);
+        else if (*cp < 0x20)
+            ok = Append_Formatted(b, "\\u%04x", *cp);
+        else
+            ok = Append_Bytes(b, cp, 1);
+        if (not ok)
+            return false;
+    }
+    return Append_Bytes(b, "\"", 1);
+}
 
-            // !!! It seems you wouldn't need the SQLWCHAR version for this,
-            // but Windows complains if you use SQLCHAR and try to call the
-            // non-W version.  :-/  Review.
-            //
-            rc = SQLGetDiagRecW(
-                SQL_HANDLE_STMT,  // HandleType
-                hstmt,  // Handle
-                1,  // RecNumber
-                state,  // SQLState
-                &native,  // NativeErrorPointer
-                nullptr,  // MessageText
-                0,  // BufferLength
-                &message_len  // TextLengthPtr
-            );
 
-            // Right now we ignore the "info" if there was success, but
-            // `state` is what you'd examine to know what the information is.
-            //
-            break; }
+//
+//  export /odbc-query-stats: native [
+//
+//  "Microsecond latencies and row counts for each shape of query run"
+//
+//      return: "OBJECT!s with SQL and PREPARE, EXECUTE, FETCH, ROWS stats"
+//          [block! text!]
+//      :json "Give the stats as JSON text instead"
+//      :reset "Start counting over after getting the stats"
+//  ]
+//
+DECLARE_NATIVE(ODBC_QUERY_STATS)
+//
+// Each of PREPARE, EXECUTE, FETCH and ROWS has the count, total, p50, p90,
+// p99 and max.  FETCH is the time of each COPY-ODBC, and ROWS is the number
+// of rows affected by DML, or given by each COPY-ODBC.  Stats are only kept
+// while ODBC-SET-QUERY-STATS has them on (see QUERY STATISTICS).
+{
+    INCLUDE_PARAMS_OF_ODBC_QUERY_STATS;
+
+    int num_shapes = g_query_stats.num_shapes;
+    if (
+        g_query_stats.shapes
+        and g_query_stats.shapes[MAX_QUERY_SHAPES].text[0] != '\0'
+    ){
+        ++num_shapes;  // the "(other)" shape
+    }
 
-          case SQL_NO_DATA:
-            goto no_more_data;
+    Value* result;
+
+    if (rebUnboxLogic("json")) {
+        ByteBuffer out = { nullptr, 0, 0 };
+        bool ok = Append_Bytes(&out, "[", 1);
+
+        int i;
+        for (i = 0; ok and i != num_shapes; ++i) {
+            const QueryShape* shape = (i == g_query_stats.num_shapes)
+                ? &g_query_stats.shapes[MAX_QUERY_SHAPES]
+                : &g_query_stats.shapes[i];
+            ok = Append_Bytes(&out, ",", i == 0 ? 0 : 1)
+                and Append_Bytes(&out, "{\"sql\":", 7)
+                and Append_JSON_String(&out, shape->text)
+                and Append_JSON_Histogram(&out, "prepare", &shape->prepare)
+                and Append_JSON_Histogram(&out, "execute", &shape->execute)
+                and Append_JSON_Histogram(&out, "fetch", &shape->fetch)
+                and Append_JSON_Histogram(&out, "rows", &shape->rows)
+                and Append_Bytes(&out, "}", 1);
+        }
+        ok = ok and Append_Bytes(&out, "]", 1);
 
-          case SQL_INVALID_HANDLE:
-          case SQL_STILL_EXECUTING:
-          case SQL_ERROR:
-          default:  // No other return codes were listed
-            return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+        if (not ok) {
+            Free_Byte_Buffer(&out);
+            return "panic -[Couldn't allocate ODBC-QUERY-STATS:JSON text]-";
+        }
+        result = rebSizedText(cast(char*, out.data), out.size);
+        Free_Byte_Buffer(&out);
+    }
+    else {
+        result = rebValue("make block!", rebI(num_shapes));
+
+        int i;
+        for (i = 0; i != num_shapes; ++i) {
+            const QueryShape* shape = (i == g_query_stats.num_shapes)
+                ? &g_query_stats.shapes[MAX_QUERY_SHAPES]
+                : &g_query_stats.shapes[i];
+            rebElide("append", result, "make object! [",
+                "sql:", rebT(shape->text),
+                "prepare:", rebR(Histogram_Object(&shape->prepare)),
+                "execute:", rebR(Histogram_Object(&shape->execute)),
+                "fetch:", rebR(Histogram_Object(&shape->fetch)),
+                "rows:", rebR(Histogram_Object(&shape->rows)),
+            "]");
         }
+    }
 
-        Value* record = rebValue("make block!", rebI(num_columns));
+    if (rebUnboxLogic("reset"))
+        Reset_Query_Stats();
 
-        SQLSMALLINT column_index;
-        for (column_index = 1; column_index <= num_columns; ++column_index) {
-            Column* col = &columns[column_index - 1];
+    return result;
+}
 
-            if (col->buffer == nullptr)
-                assert(col->buffer_size == 0);
 
-            SQLLEN len;
-            rc = SQLGetData(
-                hstmt,
-                column_index,
-                col->c_type,
-                col->buffer ? col->buffer : g_dummy_buffer,  // can't be null
-                col->buffer_size,  // zero if null
-                &len
-            );
+//
+//  export /odbc-trace: native [
+//
+//  "Turn on or off the logging of every ODBC call made, in a ring buffer"
+//
+//      return: [trash!]
+//      on [logic!]
+//      :size "How many calls the ring holds (default 65536)"
+//          [integer!]
+//  ]
+//
+DECLARE_NATIVE(ODBC_TRACE)
+//
+// Turning the trace on starts it over with an empty ring.  Turning it off
+// keeps the records, so ODBC-TRACE-SNAPSHOT can still get them.  See ODBC
+// CALL TRACE for what's recorded.
+{
+    INCLUDE_PARAMS_OF_ODBC_TRACE;
 
-            if (col->buffer == nullptr and len == SQL_NO_TOTAL)
-                return "panic -[ODBC gave SQL_NO_TOTAL for var-size field]-";
+    g_odbc_trace.on = false;
 
-            Option(SQLPOINTER) allocated;
+    if (not rebUnboxLogic("on"))
+        return "~<?>~";
 
-            switch (rc) {
-              case SQL_SUCCESS:
-                if (
-                    len != SQL_NULL_DATA
-                    and len > cast(SQLLEN, col->buffer_size)
-                ){
-                    assert(col->buffer == nullptr);  // Firebase does this (!)
-                    goto success_with_info;
-                }
-                allocated = nullptr;
-                break;
+    int64_t num_records = rebUnboxInteger64(
+        "any [size", rebI(DEFAULT_TRACE_SIZE), "]"
+    );
+    if (num_records < 1)
+        return "panic -[ODBC-TRACE:SIZE must be at least 1]-";
 
-              success_with_info:
-              case SQL_SUCCESS_WITH_INFO:  // potential truncation
-                assert(len != SQL_NULL_DATA);
-                assert(len != SQL_NO_TOTAL);
-                assert(col->buffer == nullptr);
-                allocated = rebAllocBytes(len + 1);  // can be rebRepossess()'d
+    Finish_Prefetch();  // no worker thread may be writing to the ring
 
-                if (len != 0) {  // MariaDB ODBC won't let you call with 0 len
-                    SQLLEN len_check;
-                    rc = SQLGetData(
-                        hstmt,
-                        column_index,
-                        col->c_type,
-                        unwrap allocated,
-                        len,  // amount of space in buffer
-                        &len_check
-                    );
-                    if (rc != SQL_SUCCESS)
-                        return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
+    if (g_odbc_trace.size != cast(uint64_t, num_records)) {
+        free(g_odbc_trace.ring);
+        g_odbc_trace.size = 0;
+        g_odbc_trace.ring = cast(TraceRecord*,
+            malloc(sizeof(TraceRecord) * num_records)
+        );
+        if (g_odbc_trace.ring == nullptr)
+            return "panic -[Couldn't allocate ODBC-TRACE ring]-";
+        g_odbc_trace.size = num_records;
+    }
 
-                    assert(len_check == len);
-                }
-                break;
+    memset(g_odbc_trace.ring, 0, sizeof(TraceRecord) * num_records);
+    g_odbc_trace.count = 0;
+    g_odbc_trace.flushed = 0;
+    g_odbc_trace.on = true;
 
-              case SQL_NO_DATA:
-                assert("!Got back SQL_NO_DATA from SQLGetData()");
-                goto no_more_data;
+    return "~<?>~";
+}
 
-              case SQL_ERROR:
-              case SQL_STILL_EXECUTING:
-              case SQL_INVALID_HANDLE:
-              default:  // No other return codes were listed
-                return rebDelegate("panic", Error_ODBC_Stmt(hstmt));
-            }
 
-            Value* temp = ODBC_Column_To_Rebol_Value(col, allocated, len);
+//
+//  export /odbc-trace-snapshot: native [
+//
+//  "Copy out the ODBC calls logged by ODBC-TRACE, oldest first"
+//
+//      return: "Records for ODBC-TRACE-DECODE, or how many :FLUSH wrote"
+//          [blob! integer!]
+//      :flush "Append the records to this file, and don't give them again"
+//          [file!]
+//  ]
+//
+DECLARE_NATIVE(ODBC_TRACE_SNAPSHOT)
+//
+// Calling with :FLUSH every so often builds a complete binary file of the
+// trace, so long as the ring doesn't wrap in between (gaps in SEQ show where
+// it did).  Records are 40 bytes, in the byte order of the machine.
+{
+    INCLUDE_PARAMS_OF_ODBC_TRACE_SNAPSHOT;
+
+    uint64_t count = Atomic_Load(&g_odbc_trace.count);
+    uint64_t seq = g_odbc_trace.flushed;  // seq of the last record given
+    if (count - seq > g_odbc_trace.size)
+        seq = count - g_odbc_trace.size;
+
+    bool flush = rebUnboxLogic("did flush");
+
+    if (seq == count)
+        return flush ? rebI(0) : rebValue("copy #{}");
+
+    TraceRecord* records = rebAllocN(TraceRecord, count - seq);
+    size_t num_records = 0;
+
+    for (++seq; seq <= count; ++seq) {  // see [2] of ODBC CALL TRACE
+        TraceRecord* r = &g_odbc_trace.ring[(seq - 1) % g_odbc_trace.size];
+        if (Atomic_Load(&r->seq) != seq)
+            continue;  // not written yet, or being overwritten
+        memcpy(&records[num_records], r, sizeof(TraceRecord));
+        if (Atomic_Load(&r->seq) != seq)
+            continue;
+        records[num_records].seq = seq;
+        ++num_records;
+    }
 
-            rebElide(
-                "append", record, rebQ(temp)  // rebQ for ~null~ true false
-            );
-            rebRelease(temp);
-        }
+    if (not flush)
+        return rebRepossess(records, sizeof(TraceRecord) * num_records);
 
-        rebElide("append", results, rebR(record));
-    }
+  #if TO_WINDOWS
+    SQLWCHAR* path = rebSpellWide("file-to-local:full flush");
+    FILE* file = _wfopen(cast(wchar_t*, path), L"ab");
+  #else
+    char* path = rebSpell("file-to-local:full flush");
+    FILE* file = fopen(path, "ab");
+  #endif
+    rebFree(path);
 
-  no_more_data:
+    bool ok = (file != nullptr)
+        and num_records == fwrite(
+            records, sizeof(TraceRecord), num_records, file
+        );
+    if (file != nullptr and fclose(file) != 0)
+        ok = false;
+    rebFree(records);
 
-    return results;
+    if (not ok)
+        return rebDelegate(
+            "panic [-[ODBC-TRACE-SNAPSHOT couldn't write]- flush]"
+        );
+
+    g_odbc_trace.flushed = count;
+    return rebI(num_records);
 }
 
 
 //
-//  export /update-odbc: native [
+//  export /odbc-trace-decode: native [
 //
-//      return: [trash!]
-//      connection [object!]
-//      access [logic!]
-//      commit [logic!]
+//  "Turn records from ODBC-TRACE-SNAPSHOT (or its :FLUSH file) into OBJECT!s"
+//
+//      return: "OBJECT!s with SEQ, CALL, HANDLE, RC, START, DURATION, ROWS"
+//          [block!]
+//      data [blob!]
 //  ]
 //
-DECLARE_NATIVE(UPDATE_ODBC)
+DECLARE_NATIVE(ODBC_TRACE_DECODE)
+//
+// START and DURATION are in microseconds, with START from a monotonic clock
+// (not the time of day).  ROWS is null for calls that don't count rows.
 {
-    INCLUDE_PARAMS_OF_UPDATE_ODBC;
+    INCLUDE_PARAMS_OF_ODBC_TRACE_DECODE;
 
-    // Get connection handle
-    //
-    SQLHDBC hdbc = rebUnboxHandle(SQLHDBC, "ensure handle! connection.hdbc");
+    size_t size;
+    unsigned char* bytes = rebBytes(&size, "data");
 
-    SQLRETURN rc;
+    if (size % sizeof(TraceRecord) != 0) {
+        rebFree(bytes);
+        return "panic -[ODBC-TRACE-DECODE data isn't whole records]-";
+    }
 
-    bool access = rebUnboxLogic("access");
-    rc = SQLSetConnectAttr(
-        hdbc,
-        SQL_ATTR_ACCESS_MODE,
-        p_cast(
-            SQLPOINTER*,
-            i_cast(uintptr_t,
-                access ? SQL_MODE_READ_WRITE : SQL_MODE_READ_ONLY
-            )
-        ),
-        SQL_IS_UINTEGER
+    Value* result = rebValue(
+        "make block!", rebI(size / sizeof(TraceRecord))
     );
 
-    if (not SQL_SUCCEEDED(rc))
-        return rebDelegate("panic", Error_ODBC_Dbc(hdbc));
+    size_t offset;
+    for (offset = 0; offset != size; offset += sizeof(TraceRecord)) {
+        TraceRecord r;
+        memcpy(&r, bytes + offset, sizeof(TraceRecord));  // may be unaligned
 
-    bool commit = rebUnboxLogic("commit");
-    rc = SQLSetConnectAttr(
-        hdbc,
-        SQL_ATTR_AUTOCOMMIT,
-        p_cast(
-            SQLPOINTER*,
-            i_cast(uintptr_t,
-                commit ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF
-            )
-        ),
-        SQL_IS_UINTEGER
-    );
+        if (r.function < 0 or r.function >= MAX_TRACED_FUNCTION) {
+            rebFree(bytes);
+            rebRelease(result);
+            return "panic -[ODBC-TRACE-DECODE data has an unknown call]-";
+        }
 
-    if (not SQL_SUCCEEDED(rc))
-        return rebDelegate("panic", Error_ODBC_Dbc(hdbc));
+        Value* rows = (r.rows < 0) ? nullptr : rebInteger64(r.rows);
+        rebElide("append", result, "make object! [",
+            "seq:", rebR(rebInteger64(r.seq)),
+            "call: to word!", rebT(g_traced_function_names[r.function]),
+            "handle:", rebR(rebInteger64(r.handle)),
+            "rc:", rebI(r.rc),
+            "start:", rebR(rebInteger64(r.start)),
+            "duration:", rebR(rebInteger64(r.duration)),
+            "rows:", rebQ(rows),
+        "]");
+        if (rows)
+            rebRelease(rows);
+    }
 
-    return "~<?>~";
+    rebFree(bytes);
+    return result;
 }
 
 
@@ -1881,6 +7758,8 @@ DECLARE_NATIVE(CLOSE_STATEMENT)
 {
     INCLUDE_PARAMS_OF_CLOSE_STATEMENT;
 
+    Finish_Prefetch();  // no worker thread may be using a handle
+
     Value* columns_value = rebValue(
         "ensure [<null> handle!] statement.columns"
     );
@@ -1897,7 +7776,29 @@ DECLARE_NATIVE(CLOSE_STATEMENT)
         SQLHSTMT hstmt = rebUnboxHandle(SQLHSTMT, hstmt_value);
         assert(hstmt);
 
-        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        Value* hdbc_value = rebValue(  // null if connection was closed
+            "ensure [<null> handle!] statement.database.hdbc"
+        );
+        Connection* conn = nullptr;
+        if (hdbc_value) {
+            conn = rebUnboxHandle(Connection*, hdbc_value);
+            rebRelease(hdbc_value);
+        }
+
+        bool reset_attributes = rebUnboxLogic(
+            "any [",
+                "statement.cursor <> 'forward",
+                "statement.max-rows <> 0",
+                "statement.max-length <> 0",
+            "]"
+        );
+        if (not conn or not Pool_Statement_Handle(
+            conn, hstmt, reset_attributes
+        )){
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+            if (conn)
+                ++conn->num_hstmt_frees;
+        }
 
         rebModifyHandleCData(hstmt_value, SQL_NULL_HANDLE);
         rebModifyHandleCleaner(hstmt_value, nullptr);
@@ -1922,6 +7823,8 @@ DECLARE_NATIVE(CLOSE_CONNECTION)
 {
     INCLUDE_PARAMS_OF_CLOSE_CONNECTION;
 
+    Finish_Prefetch();  // no worker thread may be using a handle
+
     Value* hdbc_value = rebValue("ensure [<null> handle!] connection.hdbc");
     if (not hdbc_value)  // connection was already closed (be tolerant?)
         return rebLogic(false);
@@ -1995,6 +7898,8 @@ DECLARE_NATIVE(SHUTDOWN_P)
 {
     INCLUDE_PARAMS_OF_SHUTDOWN_P;
 
+    Finish_Prefetch();  // no worker thread may be using a handle
+
     // There are extant pointers in HANDLE! values to the parameters, columns,
     // and connections or else they wouldn't be in the list!  So we can't
     // free the memory for them, we can only do the cleanup and mark them
@@ -2014,5 +7919,20 @@ DECLARE_NATIVE(SHUTDOWN_P)
         henv = SQL_NULL_HANDLE;
     }
 
+    Free_Arena_Blocks(&g_param_arena);
+    g_param_arena.total = 0;
+    g_param_arena.next_size = 0;
+
+    free(g_query_stats.shapes);
+    g_query_stats.shapes = nullptr;
+    Reset_Query_Stats();
+
+    g_odbc_trace.on = false;
+    free(g_odbc_trace.ring);
+    g_odbc_trace.ring = nullptr;
+    g_odbc_trace.size = 0;
+    g_odbc_trace.count = 0;
+    g_odbc_trace.flushed = 0;
+
     return "~<?>~";
 }
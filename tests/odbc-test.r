@@ -321,6 +321,209 @@ for-each [label sqltype content] tables [
     print newline
 ]
 
+=== TRANSACTIONS ===
+
+; An insert inside a transaction that panics should be rolled back, and so
+; should one in a transaction left early by BREAK (which must also end the
+; transaction, or the next BEGIN-ODBC would panic).  The inserts in a
+; transaction that completes (with intermediate :BATCH commits) should all be
+; there afterward.
+
+count-rows: func [return: [integer!]] [
+    sql-execute [SELECT val FROM test_integer_s]
+    return length of copy statement
+]
+
+rows-before: count-rows
+
+sys.util/recover [
+    odbc-transaction connection [
+        sql-execute [INSERT INTO test_integer_s (val) VALUES (1000)]
+        panic "Deliberate failure to cause a ROLLBACK"
+    ]
+]
+
+either rows-before = count-rows [
+    print "ROLLBACK DISCARDED INSERTED ROW"
+][
+    mismatches: me + 1
+    print "ROLLBACK DID NOT DISCARD INSERTED ROW"
+]
+total: total + 1
+
+sys.util/recover [
+    for-each 'value [1000] [
+        odbc-transaction connection [
+            sql-execute [INSERT INTO test_integer_s (val) VALUES ($value)]
+            break
+        ]
+    ]
+]
+
+either rows-before = count-rows [
+    print "BREAK OUT OF TRANSACTION ROLLED BACK"
+][
+    mismatches: me + 1
+    print "BREAK OUT OF TRANSACTION DID NOT ROLL BACK"
+]
+total: total + 1
+
+odbc-transaction:batch connection [
+    for-each 'value [1001 1002 1003] [
+        sql-execute [INSERT INTO test_integer_s (val) VALUES ($value)]
+    ]
+] 2
+
+either (rows-before + 3) = count-rows [
+    print "COMMIT KEPT ALL INSERTED ROWS"
+][
+    mismatches: me + 1
+    print "COMMIT DID NOT KEEP ALL INSERTED ROWS"
+]
+total: total + 1
+
+print newline
+
+=== RESULT CACHE ===
+
+; Running a cached SELECT again shouldn't execute it (which the query stats
+; show), while DML on the table from any entry point--here a raw INSERT-ODBC
+; on another statement--drops it.  So does a direct ROLLBACK-ODBC, since the
+; result cached inside the transaction holds a row that was undone.
+
+cached-count: func [return: [integer!]] [
+    sql-execute:cache [SELECT val FROM test_integer_s]
+    return length of copy statement
+]
+
+odbc-set-query-stats okay
+
+rows-before: cached-count
+again-count: cached-count  ; should be served from the cache
+
+other: odbc-statement-of connection
+insert-odbc other.locals [-[INSERT INTO test_integer_s (val) VALUES (1004)]-]
+close other
+inserted-count: cached-count
+
+begin-odbc connection
+sql-execute [INSERT INTO test_integer_s (val) VALUES (1005)]
+in-transaction-count: cached-count
+rollback-odbc connection
+rolled-back-count: cached-count
+
+executions: 0
+for-each 'shape odbc-query-stats:reset [
+    if shape.sql = "SELECT VAL FROM TEST_INTEGER_S" [
+        executions: executions + shape.execute.count
+    ]
+]
+odbc-set-query-stats null
+
+either all [
+    executions = 4  ; not 5, the second SELECT was a hit
+    rows-before = again-count
+    (rows-before + 1) = inserted-count
+    (rows-before + 2) = in-transaction-count
+    (rows-before + 1) = rolled-back-count
+][
+    print "RESULT CACHE HIT, THEN DROPPED AFTER INSERT AND ROLLBACK"
+][
+    mismatches: me + 1
+    print "RESULT CACHE DIDN'T HIT, OR GAVE STALE ROWS"
+]
+total: total + 1
+
+print newline
+
+=== QUERY STATS ===
+
+; Two queries differing only in a literal should be counted as one shape,
+; which the :JSON form names too.  :RESET then starts the counts over.
+
+odbc-set-query-stats okay
+for-each 'value [1001 1002] [
+    sql-execute compose [SELECT val FROM test_integer_s WHERE val = (value)]
+    copy statement
+]
+
+shape-sql: "SELECT VAL FROM TEST_INTEGER_S WHERE VAL = ?"
+executions: 0
+for-each 'shape odbc-query-stats [
+    if shape.sql = shape-sql [executions: executions + shape.execute.count]
+]
+json: odbc-query-stats:json:reset
+after-reset: odbc-query-stats
+odbc-set-query-stats null
+
+either all [
+    executions = 2
+    find json unspaced [-["sql":"]- shape-sql -["]-]
+    empty? after-reset
+][
+    print "QUERY STATS COUNTED ONE SHAPE"
+][
+    mismatches: me + 1
+    print "QUERY STATS DIDN'T COUNT ONE SHAPE"
+]
+total: total + 1
+
+print newline
+
+=== IMPORT ===
+
+; A field that won't convert is rejected before its batch is sent, so the
+; first batch here is short.  The full batch after it must still insert all
+; of its rows, and LOADED must match what went into the table.
+
+rows-before: count-rows
+write %odbc-import-test.csv unspaced [
+    "2001" newline "oops" newline "2003" newline "2004" newline
+    "2005" newline "2006" newline "2007" newline "2008" newline
+    "2009" newline
+]
+result: import-odbc:types:batch statement.locals (
+    "INSERT INTO test_integer_s (val) VALUES (?)"
+) %odbc-import-test.csv [integer] 4
+delete %odbc-import-test.csv
+
+either all [
+    result.loaded = 8
+    result.rejected = [2]
+    (rows-before + 8) = count-rows
+][
+    print "IMPORT LOADED EVERY GOOD ROW"
+][
+    mismatches: me + 1
+    print "IMPORT LOST ROWS OR MISCOUNTED THEM"
+]
+total: total + 1
+
+print newline
+
+=== CALL TRACE ===
+
+; With the trace on, a query should show up as (at least) one SQLExecute that
+; succeeded, which ODBC-TRACE-DECODE can read back out of the snapshot.
+
+odbc-trace okay
+sql-execute [SELECT val FROM test_integer_s]
+odbc-trace null
+executed: null
+for-each 'record odbc-trace-decode odbc-trace-snapshot [
+    if all ['SQLExecute = record.call, find [0 1] record.rc] [executed: okay]
+]
+
+either executed [
+    print "CALL TRACE HAS THE EXECUTE"
+][
+    mismatches: me + 1
+    print "CALL TRACE IS MISSING THE EXECUTE"
+]
+total: total + 1
+
+print newline
+
 ; Being a GC-oriented language, we might have code paths that don't close
 ; connections and thus we only find out about leaked C entities when the
 ; GC is being shut down--after things like the ODBC extension are unloaded.